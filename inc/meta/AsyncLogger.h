@@ -0,0 +1,326 @@
+#ifndef ZOO_META_ASYNC_LOGGER
+#define ZOO_META_ASYNC_LOGGER
+
+#include <meta/Instantiator.h>
+#include <meta/PackIndexer.h>
+#include <meta/SpscRing.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace meta {
+namespace detail {
+
+/// \brief What a conversion of a \c printf format takes: the kind of the
+/// argument and the size it has after the default promotions
+struct FormatConversion {
+    enum Kind: char {
+        Integer, Floating, String, Pointer, Unsupported
+    } kind = Unsupported;
+    std::size_t size = 0;
+};
+
+constexpr bool formatDigit(char c) { return '0' <= c && c <= '9'; }
+
+/// \brief Walks the arguments of a \c printf format, those of the conversions
+/// and of the widths and precisions given as \c *, storing the one of index
+/// \c n in \c found
+/// \return the count of arguments
+constexpr std::size_t
+formatArguments(const char *format, std::size_t n, FormatConversion *found) {
+    std::size_t rv = 0;
+    auto argument = [&](FormatConversion c) {
+        if(rv++ == n) { *found = c; }
+    };
+    constexpr FormatConversion Int = { FormatConversion::Integer, sizeof(int) };
+    for(; *format; ++format) {
+        if('%' != *format) { continue; }
+        if('%' == *++format) { continue; }
+        while(*format && std::char_traits<char>::find("-+ #0", 5, *format)) {
+            ++format;
+        }
+        if('*' == *format) { argument(Int); ++format; }
+        while(formatDigit(*format)) { ++format; }
+        if('.' == *format) {
+            if('*' == *++format) { argument(Int); ++format; }
+            while(formatDigit(*format)) { ++format; }
+        }
+        std::size_t integer = sizeof(int);
+        auto floating = sizeof(double);
+        auto plain = true;
+        switch(*format) {
+            case 'h': plain = false; format += 'h' == format[1]; break;
+            case 'l':
+                plain = false;
+                if('l' == format[1]) { ++format; integer = sizeof(long long); }
+                else { integer = sizeof(long); }
+                break;
+            case 'j': plain = false; integer = sizeof(std::intmax_t); break;
+            case 'z': plain = false; integer = sizeof(std::size_t); break;
+            case 't': plain = false; integer = sizeof(std::ptrdiff_t); break;
+            case 'L':
+                plain = false;
+                integer = 0;
+                floating = sizeof(long double);
+                break;
+            default: --format;
+        }
+        ++format;
+        FormatConversion c;
+        switch(*format) {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+                if(integer) { c = { FormatConversion::Integer, integer }; }
+                break;
+            case 'c': if(plain) { c = Int; } break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            case 'a': case 'A':
+                c = { FormatConversion::Floating, floating };
+                break;
+            case 's': if(plain) { c = { FormatConversion::String, 0 }; } break;
+            case 'p': if(plain) { c = { FormatConversion::Pointer, 0 }; } break;
+            default: break; // %n and wide characters are not logged
+        }
+        argument(c);
+        if(!*format) { break; }
+    }
+    return rv;
+}
+
+/// \brief the arguments a \c printf format takes, "%%" is none
+constexpr std::size_t formatConversions(const char *format) {
+    FormatConversion ignored;
+    return formatArguments(format, ~std::size_t(0), &ignored);
+}
+
+constexpr FormatConversion formatConversion(const char *format, std::size_t n) {
+    FormatConversion rv;
+    formatArguments(format, n, &rv);
+    return rv;
+}
+
+/// \brief Whether \c T is what \c c takes: integers and floating points of
+/// the size, after promotion, of its length modifier, in any signedness
+template<typename T>
+constexpr bool formatMatches(FormatConversion c) {
+    std::size_t promoted = 0;
+    if constexpr(std::is_floating_point<T>::value) {
+        promoted = std::is_same<T, float>::value ? sizeof(double) : sizeof(T);
+    } else if constexpr(std::is_integral<T>::value) {
+        promoted = sizeof(+std::declval<T>());
+    }
+    switch(c.kind) {
+        case FormatConversion::Integer:
+            return std::is_integral<T>::value && promoted == c.size;
+        case FormatConversion::Floating:
+            return std::is_floating_point<T>::value && promoted == c.size;
+        case FormatConversion::String:
+            return std::is_same<std::decay_t<T>, const char *>::value ||
+                std::is_same<std::decay_t<T>, char *>::value;
+        case FormatConversion::Pointer: return std::is_pointer<T>::value;
+        default: return false;
+    }
+}
+
+template<typename... Ts, std::size_t... Indices>
+constexpr bool
+formatMatches(const char *format, std::index_sequence<Indices...>) {
+    return (formatMatches<Ts>(formatConversion(format, Indices)) && ...);
+}
+
+template<std::size_t, typename T>
+struct LogArgument { T value; };
+
+template<typename Indices, typename... Ts>
+struct LogArguments;
+
+/// \brief the arguments as a trivially copyable aggregate
+template<std::size_t... Indices, typename... Ts>
+struct LogArguments<std::index_sequence<Indices...>, Ts...>:
+    LogArgument<Indices, Ts>...
+{
+    void print(std::FILE *out, const char *format) const {
+        std::fprintf(
+            out, format,
+            static_cast<const LogArgument<Indices, Ts> &>(*this).value...
+        );
+    }
+};
+
+}
+
+/// \brief A log site: its format, a string with static storage, and the
+/// types of its arguments, copied as bytes.  It is also the record of a call
+/// \note pointer arguments are copied as pointers, a string must outlive its
+/// formatting in the background, a literal does
+template<const char *Format, typename... Arguments>
+struct LogSite {
+    static_assert(
+        (std::is_trivially_copyable<Arguments>::value && ...),
+        "Log arguments are copied as bytes"
+    );
+    static_assert(
+        detail::formatConversions(Format) == sizeof...(Arguments),
+        "One argument per conversion of the format"
+    );
+    static_assert(
+        detail::formatMatches<Arguments...>(
+            Format, std::index_sequence_for<Arguments...>()
+        ),
+        "An argument does not match its conversion in the format"
+    );
+
+    constexpr static const char *format = Format;
+
+    detail::LogArguments<
+        std::index_sequence_for<Arguments...>, Arguments...
+    > arguments;
+
+    static LogSite make(Arguments... values) noexcept {
+        return { { { values }... } };
+    }
+};
+
+namespace detail {
+
+template<typename Site>
+struct LogFormatter {
+    static void execute(std::FILE *out, const void *record) {
+        static_cast<const Site *>(record)->arguments.print(out, Site::format);
+    }
+};
+
+template<typename Sites>
+struct LogDispatch;
+
+template<typename... Sites>
+struct LogDispatch<Pack<Sites...>> {
+    static void execute(std::FILE *out, const void *record, std::size_t index) {
+        Instantiator<
+            PackIndexer<LogFormatter, Pack<Sites...>>::template Internal,
+            sizeof...(Sites),
+            void(std::FILE *, const void *)
+        >::execute(out, record, index);
+    }
+};
+
+}
+
+/// \brief Logger whose calls only copy the site index and the argument bytes
+/// into a ring of the calling thread; a background thread formats the records
+/// dispatching the index through an \c Instantiator table of per site
+/// formatters, each a \c fprintf with its format fixed at compile time
+///
+/// A thread logs through its own \c Writer, whose ring is registered once;
+/// after that a call neither allocates nor locks, and does not wait: when
+/// the ring is full the record is dropped and counted.  The background
+/// thread sweeps the rings and sleeps \c period when they are all empty
+/// \note the records of a thread are formatted in order, those of different
+/// threads are not ordered
+template<typename Sites>
+class AsyncLogger {
+    using Ring = SpscRing<Sites>;
+
+    std::FILE *out_;
+    std::size_t capacity_;
+    std::chrono::microseconds period_;
+    std::mutex mutex_; ///< of the registration of rings
+    std::vector<std::unique_ptr<Ring>> rings_;
+    std::atomic<std::size_t> registered_{0};
+    std::atomic<bool> stop_{false};
+    std::uint64_t formatted_ = 0;
+    std::thread background_;
+
+    void run() {
+        std::vector<RingConsumer<Sites>> consumers;
+        auto sink = [this](const void *record, std::size_t index) {
+            detail::LogDispatch<Sites>::execute(out_, record, index);
+        };
+        for(;;) {
+            auto stopping = stop_.load(std::memory_order_acquire);
+            auto registered = registered_.load(std::memory_order_acquire);
+            if(consumers.size() != registered) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for(auto i = consumers.size(); i < rings_.size(); ++i) {
+                    consumers.push_back(rings_[i]->consumer());
+                }
+            }
+            std::size_t swept = 0;
+            for(auto &c: consumers) { swept += c.poll(sink); }
+            formatted_ += swept;
+            if(swept) { continue; }
+            if(stopping) { break; }
+            std::fflush(out_);
+            std::this_thread::sleep_for(period_);
+        }
+        std::fflush(out_);
+    }
+
+public:
+    /// \brief The handle of one thread to log
+    class Writer {
+        RingProducer<Sites> producer_;
+        std::uint64_t dropped_ = 0;
+
+    public:
+        explicit Writer(Ring &ring): producer_(ring.producer()) {}
+
+        template<typename Site, typename... Arguments>
+        void log(const Arguments &...arguments) noexcept {
+            if(producer_.push(Site::make(arguments...))) {
+                producer_.publish();
+            } else {
+                ++dropped_;
+            }
+        }
+
+        std::uint64_t dropped() const noexcept { return dropped_; }
+    };
+
+    /// \param capacity in bytes of the ring of each writer, a power of two
+    explicit AsyncLogger(
+        std::FILE *out, std::size_t capacity = 1 << 20,
+        std::chrono::microseconds period = std::chrono::microseconds(1000)
+    ):
+        out_(out), capacity_(capacity), period_(period),
+        background_([this] { run(); })
+    {}
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    ~AsyncLogger() { stop(); }
+
+    /// \brief Registers a ring for the calling thread, not in the hot path
+    Writer writer() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings_.push_back(std::make_unique<Ring>(capacity_));
+        registered_.store(rings_.size(), std::memory_order_release);
+        return Writer(*rings_.back());
+    }
+
+    /// \brief Formats what was logged before and ends the background thread
+    /// \return how many records were formatted
+    std::uint64_t stop() {
+        if(background_.joinable()) {
+            stop_.store(true, std::memory_order_release);
+            background_.join();
+        }
+        return formatted_;
+    }
+};
+
+}
+
+#endif
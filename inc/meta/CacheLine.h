@@ -0,0 +1,21 @@
+#ifndef ZOO_META_CACHE_LINE
+#define ZOO_META_CACHE_LINE
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#endif
+
+namespace meta {
+
+/// \note not \c std::hardware_destructive_interference_size, GCC warns its
+/// value may change across compiler versions and flags, an ABI hazard;
+/// inline, an exported template can not use a constant of internal linkage
+#ifdef ZOO_META_CACHE_LINE_SIZE
+inline constexpr std::size_t CacheLineSize = ZOO_META_CACHE_LINE_SIZE;
+#else
+inline constexpr std::size_t CacheLineSize = 64;
+#endif
+
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef ZOO_META_CONFLATOR
+#define ZOO_META_CONFLATOR
+
+#include <meta/IndexOf.h>
+#include <meta/PackAlgorithms.h>
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace meta {
+namespace detail {
+
+template<typename Selected, typename All>
+struct ConflationLayout;
+
+template<typename... Ss, typename All>
+struct ConflationLayout<Pack<Ss...>, All> {
+    static_assert(
+        sizeof...(Ss) <= 63, "The pending set is a 64 bit mask, and a flag"
+    );
+    static_assert(
+        (std::is_trivially_copyable<Ss>::value && ...),
+        "Conflated messages are stored as bytes"
+    );
+
+    constexpr static std::size_t count = sizeof...(Ss);
+    constexpr static std::size_t size =
+        std::max({ std::size_t(1), sizeof(Ss)... });
+    constexpr static std::size_t alignment =
+        std::max({ alignof(char), alignof(Ss)... });
+    /// \brief index in \c All of each conflated type
+    constexpr static std::size_t positions[count ? count : 1] = {
+        IndexOf_v<Ss, All>...
+    };
+};
+
+template<typename A, typename Selected>
+constexpr std::size_t conflationSlot() {
+    if constexpr(Contains_v<A, Selected>) {
+        return IndexOf_v<A, Selected>;
+    } else {
+        return ~std::size_t(0);
+    }
+}
+
+/// \brief by index in \c All, the slot of each type and its size
+template<typename Selected, typename All>
+struct ConflationSlots;
+
+template<typename Selected, typename... As>
+struct ConflationSlots<Selected, Pack<As...>> {
+    constexpr static std::size_t slots[] = {
+        conflationSlot<As, Selected>()...
+    };
+    constexpr static std::size_t sizes[] = { sizeof(As)... };
+};
+
+}
+
+/// \brief Staging buffer in front of a slow consumer: the messages of the
+/// types \c T of \c P with <tt>Conflated<T>::value</tt> overwrite a pending
+/// slot per key and type, the rest bypass it
+///
+/// \c drain delivers the final message of each pending slot, keys in the
+/// order they were first touched, types in the order of \c P, to a
+/// \c Sink_t; \c flush does it for one key, ahead of a message that must
+/// not overtake them
+/// \note the selection is done at compile time, there is no branching on the
+/// type; the storage is sized at construction, nothing allocates afterwards
+template<typename P, template<typename> class Conflated>
+class Conflator {
+public:
+    using conflated_t = Filter_t<Conflated, P>;
+
+private:
+    using Layout = detail::ConflationLayout<conflated_t, P>;
+    using Slots = detail::ConflationSlots<conflated_t, P>;
+
+    struct alignas(Layout::alignment) Slot {
+        unsigned char bytes[Layout::size];
+    };
+
+    std::vector<Slot> slots_; ///< \c Layout::count per key
+    /// \brief mask of types per key, and \c Listed
+    std::vector<std::uint64_t> pending_;
+    std::vector<std::uint32_t> dirty_; ///< keys with pending slots
+
+    /// \brief the key is in \c dirty_, it may stay after a \c flush
+    constexpr static std::uint64_t Listed = std::uint64_t(1) << 63;
+
+    void store(
+        std::size_t key, std::size_t type, const void *m, std::size_t size
+    ) {
+        std::memcpy(slots_[key * Layout::count + type].bytes, m, size);
+        auto &mask = pending_[key];
+        if(!(mask & Listed)) { dirty_.push_back(std::uint32_t(key)); }
+        mask |= Listed | std::uint64_t(1) << type;
+    }
+
+    template<typename Sink>
+    void deliver(std::size_t key, std::uint64_t mask, Sink &sink) {
+        auto slots = &slots_[key * Layout::count];
+        while(mask) {
+            auto type = std::size_t(__builtin_ctzll(mask));
+            mask &= mask - 1;
+            sink(
+                static_cast<const void *>(slots[type].bytes),
+                Layout::positions[type]
+            );
+        }
+    }
+
+public:
+    explicit Conflator(std::size_t keys):
+        slots_(keys * Layout::count), pending_(keys, 0)
+    {
+        dirty_.reserve(keys);
+    }
+
+    template<typename Message>
+    constexpr static bool conflates = Contains_v<Message, conflated_t>;
+
+    /// \brief Stores \c m as the pending message of its type for \c key, or
+    /// forwards it to \c sink at once if its type is not conflated
+    template<typename Message, typename Sink>
+    void push(std::size_t key, const Message &m, Sink &&sink) {
+        if constexpr(conflates<Message>) {
+            store(key, IndexOf_v<Message, conflated_t>, &m, sizeof(m));
+        } else {
+            sink(static_cast<const void *>(&m), IndexOf_v<Message, P>);
+        }
+    }
+
+    /// \brief \c push of a message known only by its index in \c P, the
+    /// slot and size come from tables by index
+    template<typename Sink>
+    void push(
+        std::size_t key, const void *message, std::size_t index, Sink &&sink
+    ) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        auto type = Slots::slots[index];
+        if(Layout::count <= type) {
+            sink(message, index);
+            return;
+        }
+        store(key, type, message, Slots::sizes[index]);
+    }
+
+    template<typename Sink>
+    void drain(Sink &&sink) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        for(auto key: dirty_) {
+            auto mask = pending_[key] & ~Listed;
+            pending_[key] = 0;
+            deliver(key, mask, sink);
+        }
+        dirty_.clear();
+    }
+
+    template<typename Sink>
+    void flush(std::size_t key, Sink &&sink) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        auto mask = pending_[key] & ~Listed;
+        pending_[key] &= Listed;
+        deliver(key, mask, sink);
+    }
+
+    /// \brief number of keys with pending messages, or flushed since the
+    /// last \c drain
+    std::size_t dirtyCount() const noexcept { return dirty_.size(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef ZOO_META_EPOCH_RECLAIMER
+#define ZOO_META_EPOCH_RECLAIMER
+
+#include <meta/CacheLine.h>
+#include <meta/IndexOf.h>
+#include <meta/Instantiator.h>
+#include <meta/PackIndexer.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#endif
+
+namespace meta {
+namespace detail {
+
+template<typename T>
+struct EpochDelete {
+    static void execute(void *object) { delete static_cast<T *>(object); }
+};
+
+template<typename P>
+struct EpochDeleter;
+
+template<typename... Ts>
+struct EpochDeleter<Pack<Ts...>> {
+    static void execute(void *object, std::size_t index) {
+        Instantiator<
+            PackIndexer<EpochDelete, Pack<Ts...>>::template Internal,
+            sizeof...(Ts),
+            void(void *)
+        >::execute(object, index);
+    }
+};
+
+}
+
+/// \brief Epoch based reclamation of messages of the types of \c P allocated
+/// with \c new and shared by pointer among threads, without reference counts
+///
+/// Each thread joins as a \c Participant and reads the shared messages while
+/// pinned; unpinning is its quiescent point.  A message unlinked from where
+/// the readers find it is retired, tagged with the global epoch, and deleted
+/// once the epoch advanced twice: the epoch only advances when all of the
+/// pinned participants are pinned in it, thus no reader can still hold the
+/// message.  The readers pay a store and a fence per pin, shared by all of
+/// the reads of a batch, and never write to the messages' cache lines.  The
+/// deletion dispatches on the index in \c P through an \c Instantiator, the
+/// retired list needs no virtual destructors
+/// \note a participant pinned for long stops the reclamation of all
+template<typename P, std::size_t MaxParticipants = 64>
+class EpochDomain {
+    constexpr static std::uint64_t Quiescent = 0;
+    constexpr static std::size_t CollectEvery = 64;
+
+    struct Retired {
+        void *object;
+        std::size_t index;
+        std::uint64_t epoch;
+    };
+
+    struct alignas(CacheLineSize) Record {
+        std::atomic<std::uint64_t> epoch{Quiescent}; ///< pinned in, or not
+        std::atomic<bool> used{false};
+        // only touched by the participant that owns the record
+        std::vector<Retired> retired;
+        std::size_t sealed = 0; ///< retired entries already tagged
+    };
+
+    alignas(CacheLineSize) std::atomic<std::uint64_t> global_{1};
+    std::atomic<std::size_t> records_{0}; ///< high water of the used records
+    Record table_[MaxParticipants];
+
+    static void destroy(const Retired &r) {
+        detail::EpochDeleter<P>::execute(r.object, r.index);
+    }
+
+    /// \brief advances the global epoch if all the pinned are pinned in it
+    void tryAdvance() noexcept {
+        auto epoch = global_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto count = records_.load(std::memory_order_acquire);
+        for(std::size_t i = 0; i < count; ++i) {
+            auto e = table_[i].epoch.load(std::memory_order_relaxed);
+            if(Quiescent != e && epoch != e) { return; }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        global_.compare_exchange_strong(
+            epoch, epoch + 1, std::memory_order_release,
+            std::memory_order_relaxed
+        );
+    }
+
+    void collect(Record &r) {
+        // the retired were unlinked before, the tag must not be older
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto epoch = global_.load(std::memory_order_relaxed);
+        for(auto i = r.sealed; i < r.retired.size(); ++i) {
+            r.retired[i].epoch = epoch;
+        }
+        r.sealed = r.retired.size();
+        tryAdvance();
+        epoch = global_.load(std::memory_order_acquire);
+        std::size_t freed = 0;
+        // tagged in order, the reclaimable ones are a prefix
+        while(freed < r.sealed && r.retired[freed].epoch + 2 <= epoch) {
+            destroy(r.retired[freed++]);
+        }
+        r.retired.erase(r.retired.begin(), r.retired.begin() + freed);
+        r.sealed -= freed;
+    }
+
+public:
+    /// \brief The membership of a thread, not to be shared with others
+    class Participant {
+        friend EpochDomain;
+
+        EpochDomain *domain_;
+        Record *record_;
+
+        Participant(EpochDomain &d, Record &r): domain_(&d), record_(&r) {}
+
+    public:
+        Participant(Participant &&other) noexcept:
+            domain_(other.domain_), record_(other.record_)
+        {
+            other.record_ = nullptr;
+        }
+
+        Participant(const Participant &) = delete;
+        Participant &operator=(const Participant &) = delete;
+        Participant &operator=(Participant &&) = delete;
+
+        ~Participant() {
+            if(!record_) { return; }
+            unpin();
+            domain_->collect(*record_);
+            // what could not be freed yet stays for the next owner
+            record_->used.store(false, std::memory_order_release);
+        }
+
+        /// \brief From here to \c unpin the shared messages read stay alive
+        void pin() noexcept {
+            auto epoch = domain_->global_.load(std::memory_order_relaxed);
+            record_->epoch.store(epoch, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        /// \brief The quiescent point, no message read before may be used
+        void unpin() noexcept {
+            record_->epoch.store(Quiescent, std::memory_order_release);
+        }
+
+        /// \brief Hands \c message, no longer reachable by new readers, to
+        /// the domain, to be deleted when no reader may still have it
+        template<typename Message>
+        void retire(Message *message) {
+            record_->retired.push_back(
+                { message, IndexOf_v<Message, P>, Quiescent }
+            );
+            if(CollectEvery <= record_->retired.size() - record_->sealed) {
+                domain_->collect(*record_);
+            }
+        }
+
+        /// \brief Retired messages not deleted yet
+        std::size_t pending() const noexcept {
+            return record_->retired.size();
+        }
+    };
+
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    /// \brief Deletes all the retired messages, there must be no participants
+    ~EpochDomain() {
+        for(auto &r: table_) {
+            for(auto &retired: r.retired) { destroy(retired); }
+        }
+    }
+
+    /// \throw std::length_error if there are \c MaxParticipants already
+    Participant join() {
+        for(std::size_t i = 0; i < MaxParticipants; ++i) {
+            auto &r = table_[i];
+            auto used = false;
+            if(
+                !r.used.load(std::memory_order_relaxed) &&
+                r.used.compare_exchange_strong(
+                    used, true, std::memory_order_acquire
+                )
+            ) {
+                auto count = records_.load(std::memory_order_relaxed);
+                while(
+                    count <= i &&
+                    !records_.compare_exchange_weak(
+                        count, i + 1, std::memory_order_release
+                    )
+                ) {}
+                return Participant(*this, r);
+            }
+        }
+        throw std::length_error("No free epoch participant");
+    }
+
+    std::uint64_t epoch() const noexcept {
+        return global_.load(std::memory_order_acquire);
+    }
+};
+
+}
+
+#endif
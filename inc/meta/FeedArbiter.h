@@ -0,0 +1,171 @@
+#ifndef ZOO_META_FEED_ARBITER
+#define ZOO_META_FEED_ARBITER
+
+#include <meta/CacheLine.h>
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#endif
+
+namespace meta {
+
+/// \brief Lock-free set of the sequence numbers seen in a sliding window of
+/// \c Size of them, one bit per sequence number
+///
+/// Each word has 32 bits of sequence numbers and, in its upper half, the
+/// generation (sequence / \c Size) they belong to.  A claim of a newer
+/// generation replaces the word, thus the window slides without anybody
+/// clearing it, and claims of older generations fail as stale
+template<std::size_t Size>
+class SequenceWindow {
+    static_assert(Size && 0 == Size % 32, "Whole words of 32 sequences");
+    constexpr static std::size_t Words = Size / 32;
+
+    std::atomic<std::uint64_t> words_[Words] = {};
+
+public:
+    /// \brief true only for the first claim of \c sequence
+    bool claim(std::uint64_t sequence) noexcept {
+        auto generation = std::uint32_t(sequence / Size);
+        auto bit = std::uint64_t(1) << (sequence % 32);
+        auto &word = words_[(sequence % Size) / 32];
+        auto current = word.load(std::memory_order_relaxed);
+        for(;;) {
+            auto wordGeneration = std::uint32_t(current >> 32);
+            std::uint64_t desired;
+            if(wordGeneration == generation) {
+                if(current & bit) { return false; }
+                desired = current | bit;
+            } else if(std::int32_t(generation - wordGeneration) < 0) {
+                return false;
+            } else {
+                desired = (std::uint64_t(generation) << 32) | bit;
+            }
+            if(
+                word.compare_exchange_weak(
+                    current, desired, std::memory_order_acq_rel,
+                    std::memory_order_relaxed
+                )
+            ) { return true; }
+        }
+    }
+};
+
+/// \brief Arbitration of \c Feeds redundant sequenced feeds, each offered by
+/// its own thread, into one in-order stream consumed by a single thread
+///
+/// The first copy of each sequence number wins its \c SequenceWindow claim
+/// and is stored in the slot of its sequence; \c poll delivers the slots in
+/// sequence order to a \c Sink_t.  A sequence that every feed
+/// went past is a gap: it is reported to the gap sink and skipped, late copies
+/// of it are stale.
+/// \note producers wait about \c Size sequences ahead of the consumer, a
+/// feed that is a whole window ahead also makes the sequence a gap, thus a
+/// stalled feed delays the others by at most a window
+template<std::size_t Size, std::size_t MessageBytes, std::size_t Feeds = 2>
+class FeedArbiter {
+    static_assert(0 == (Size & (Size - 1)), "Size must be a power of two");
+
+    struct Slot {
+        std::atomic<std::uint64_t> published{0}; ///< sequence + 1
+        std::size_t index;
+        alignas(8) unsigned char bytes[MessageBytes];
+    };
+
+    struct alignas(CacheLineSize) Progress {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    alignas(CacheLineSize) std::atomic<std::uint64_t> head_;
+    Progress seen_[Feeds]; ///< the sequences before it were offered
+    std::uint64_t gaps_ = 0;
+    SequenceWindow<Size> window_;
+    Slot slots_[Size];
+
+public:
+    explicit FeedArbiter(std::uint64_t first = 0): head_(first) {
+        for(auto &s: seen_) { s.value.store(first); }
+    }
+
+    FeedArbiter(const FeedArbiter &) = delete;
+    FeedArbiter &operator=(const FeedArbiter &) = delete;
+
+    /// \brief Called by the thread of \c feed, in its sequence order
+    /// \return whether this was the first copy
+    bool offer(
+        std::size_t feed, std::uint64_t sequence, std::size_t index,
+        const void *message, std::size_t size
+    ) noexcept {
+        bool first = false;
+        seen_[feed].value.store(sequence, std::memory_order_release);
+        if(head_.load(std::memory_order_acquire) <= sequence) {
+            while(
+                windowEnd(head_.load(std::memory_order_acquire)) <= sequence
+            ) { std::this_thread::yield(); }
+            if(window_.claim(sequence)) {
+                auto &slot = slots_[sequence % Size];
+                slot.index = index;
+                std::memcpy(slot.bytes, message, size);
+                slot.published.store(sequence + 1, std::memory_order_release);
+                first = true;
+            }
+        }
+        seen_[feed].value.store(sequence + 1, std::memory_order_release);
+        return first;
+    }
+
+    /// \brief Delivers up to \c limit messages in sequence order
+    /// \return the number of sequences consumed, delivered or gaps
+    template<typename Sink, typename GapSink>
+    std::size_t poll(Sink &&sink, GapSink &&gap, std::size_t limit = Size) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        auto head = head_.load(std::memory_order_relaxed);
+        std::size_t consumed = 0;
+        for(; consumed < limit; ++consumed) {
+            auto &slot = slots_[head % Size];
+            if(head + 1 == slot.published.load(std::memory_order_acquire)) {
+                sink(static_cast<const void *>(slot.bytes), slot.index);
+            } else if(lost(head) && window_.claim(head)) {
+                ++gaps_;
+                gap(head);
+            } else {
+                break; // not arrived yet, or being written
+            }
+            head_.store(++head, std::memory_order_release);
+        }
+        return consumed;
+    }
+
+    std::uint64_t next() const noexcept {
+        return head_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t gaps() const noexcept { return gaps_; }
+
+private:
+    /// \brief the first sequence that can not be claimed yet: the window
+    /// words have 32 sequences, all of the word of the previous generation
+    /// must have been consumed
+    constexpr static std::uint64_t windowEnd(std::uint64_t head) noexcept {
+        return (head & ~std::uint64_t(31)) + Size;
+    }
+
+    bool lost(std::uint64_t sequence) const noexcept {
+        auto all = true;
+        for(auto &s: seen_) {
+            auto v = s.value.load(std::memory_order_acquire);
+            if(windowEnd(sequence) <= v) { return true; }
+            all = all && sequence < v;
+        }
+        return all;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef ZOO_META_INDEX_OF
+#define ZOO_META_INDEX_OF
+
+#include <meta/TypeAtIndex.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#include <type_traits>
+#endif
+
+namespace meta {
+namespace detail {
+
+template<typename T, std::size_t Index>
+std::integral_constant<std::size_t, Index>
+indexOf(const IndexedType<Index, T> *);
+
+template<bool Unique, typename T, typename... Ts>
+struct IndexOfUnique {
+    constexpr static std::size_t value = sizeof...(Ts);
+};
+
+template<typename T, typename... Ts>
+struct IndexOfUnique<true, T, Ts...> {
+    constexpr static std::size_t value =
+        decltype(
+            indexOf<T>(
+                static_cast<
+                    IndexedTypes<
+                        MakeIndexPack<std::size_t, sizeof...(Ts)>, Ts...
+                    > *
+                >(nullptr)
+            )
+        )::value;
+};
+
+}
+
+/// \brief The inverse of \c TypeAtIndex: the position of \c T in \c Ts,
+/// which must appear exactly once
+/// \note resolved by overload resolution, the instantiation depth is constant
+template<typename T, typename... Ts>
+struct IndexOf {
+    constexpr static auto occurrences =
+        (std::size_t(0) + ... + std::size_t(std::is_same<T, Ts>::value));
+
+    static_assert(0 != occurrences, "IndexOf: the type is not in the pack");
+    static_assert(
+        occurrences < 2, "IndexOf: the type appears more than once in the pack"
+    );
+
+    constexpr static std::size_t value =
+        detail::IndexOfUnique<1 == occurrences, T, Ts...>::value;
+};
+
+template<typename T, typename... Ts>
+struct IndexOf<T, Pack<Ts...>>: IndexOf<T, Ts...> {};
+
+template<typename T, typename... Ts>
+constexpr std::size_t IndexOf_v = IndexOf<T, Ts...>::value;
+
+}
+
+#endif
@@ -0,0 +1,282 @@
+#ifndef ZOO_META_INDEX_PACK_ALGORITHMS
+#define ZOO_META_INDEX_PACK_ALGORITHMS
+
+#include "meta/Indices.h"
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cstddef>
+#endif
+
+/// \file IndexPackAlgorithms.h
+/// Value-level algorithms over \c IndexPack.  The values are copied into a
+/// \c constexpr array, the result is computed with plain loops and the pack is
+/// reconstituted from it, thus the instantiation depth does not depend on the
+/// arity.
+
+namespace meta {
+
+template<typename T, T... vs>
+constexpr std::array<T, sizeof...(vs)> toArray(IndexPack<T, vs...>) {
+    return {{ vs... }};
+}
+
+namespace detail {
+
+/// \brief Plain array, GCC evaluates subscripts on it several times faster than
+/// on \c std::array in constant expressions
+template<typename T, std::size_t Capacity>
+struct ValueBuffer {
+    T values[Capacity ? Capacity : 1] = {};
+    std::size_t count = 0;
+
+    constexpr void push(T v) { values[count++] = v; }
+};
+
+/// \brief Indices of \c source in ascending order of value; equal values keep
+/// their relative order
+/// \note bottom-up merge sort
+template<typename T, std::size_t N>
+constexpr ValueBuffer<std::size_t, N>
+stableOrder(ValueBuffer<T, N> source) {
+    ValueBuffer<std::size_t, N> order, buffer;
+    for(std::size_t i = 0; i < N; ++i) { order.push(i); }
+    buffer.count = N;
+    for(std::size_t width = 1; width < N; width *= 2) {
+        for(std::size_t low = 0; low < N; low += 2 * width) {
+            auto middle = low + width < N ? low + width : N;
+            auto high = low + 2 * width < N ? low + 2 * width : N;
+            auto left = low, right = middle, out = low;
+            auto &from = order.values, &to = buffer.values;
+            while(left < middle && right < high) {
+                to[out++] =
+                    source.values[from[right]] < source.values[from[left]] ?
+                        from[right++] : from[left++];
+            }
+            while(left < middle) { to[out++] = from[left++]; }
+            while(right < high) { to[out++] = from[right++]; }
+        }
+        order = buffer;
+    }
+    return order;
+}
+
+/// \brief Converts the \c buffer of the \c Computation back into an
+/// \c IndexPack
+template<
+    typename Computation,
+    typename = MakeIndexPack<std::size_t, Computation::buffer.count>
+>
+struct Materialize;
+
+template<typename Computation, std::size_t... is>
+struct Materialize<Computation, IndexPack<std::size_t, is...>> {
+    using type =
+        IndexPack<
+            typename Computation::value_type,
+            Computation::buffer.values[is]...
+        >;
+};
+
+template<typename P> struct PackValues;
+
+/// \note The computations below copy \c buffer into a local before looping:
+/// GCC copies the whole initializer of a static member on every access
+template<typename T, T... vs>
+struct PackValues<IndexPack<T, vs...>> {
+    using value_type = T;
+    constexpr static std::size_t arity = sizeof...(vs);
+    constexpr static ValueBuffer<T, arity> buffer = {{ vs... }, arity};
+    constexpr static std::array<T, arity> array = {{ vs... }};
+};
+
+template<typename P, std::size_t Begin, std::size_t End>
+struct SliceComputation: PackValues<P> {
+    static_assert(Begin <= End && End <= PackValues<P>::arity, "Bad slice");
+
+    constexpr static auto buffer = [] {
+        auto source = PackValues<P>::buffer;
+        ValueBuffer<typename PackValues<P>::value_type, End - Begin> rv;
+        for(auto i = Begin; i < End; ++i) { rv.push(source.values[i]); }
+        return rv;
+    }();
+};
+
+template<typename P>
+struct ReverseComputation: PackValues<P> {
+    constexpr static auto buffer = [] {
+        auto source = PackValues<P>::buffer;
+        ValueBuffer<
+            typename PackValues<P>::value_type, PackValues<P>::arity
+        > rv;
+        for(auto i = source.count; i--; ) { rv.push(source.values[i]); }
+        return rv;
+    }();
+};
+
+template<typename P, typename... Ps>
+struct ConcatComputation {
+    using value_type = typename PackValues<P>::value_type;
+    constexpr static auto buffer = [] {
+        ValueBuffer<
+            value_type,
+            (PackValues<P>::arity + ... + PackValues<Ps>::arity)
+        > rv;
+        auto append = [&](auto source) {
+            for(std::size_t i = 0; i < source.count; ++i) {
+                rv.push(source.values[i]);
+            }
+        };
+        append(PackValues<P>::buffer);
+        (append(PackValues<Ps>::buffer), ...);
+        return rv;
+    }();
+};
+
+template<typename P>
+struct SortComputation: PackValues<P> {
+    constexpr static auto buffer = [] {
+        auto source = PackValues<P>::buffer;
+        auto order = stableOrder(source);
+        ValueBuffer<
+            typename PackValues<P>::value_type, PackValues<P>::arity
+        > rv;
+        for(std::size_t i = 0; i < source.count; ++i) {
+            rv.push(source.values[order.values[i]]);
+        }
+        return rv;
+    }();
+};
+
+template<typename P>
+struct UniqueComputation: PackValues<P> {
+    constexpr static auto buffer = [] {
+        auto source = PackValues<P>::buffer;
+        auto order = stableOrder(source);
+        constexpr auto N = PackValues<P>::arity;
+        ValueBuffer<bool, N> first;
+        for(std::size_t i = 0; i < N; ++i) {
+            auto current = order.values[i];
+            first.values[current] =
+                0 == i ||
+                source.values[order.values[i - 1]] < source.values[current];
+        }
+        ValueBuffer<typename PackValues<P>::value_type, N> rv;
+        for(std::size_t i = 0; i < N; ++i) {
+            if(first.values[i]) { rv.push(source.values[i]); }
+        }
+        return rv;
+    }();
+};
+
+template<typename P, bool Inclusive>
+struct ScanComputation: PackValues<P> {
+    constexpr static auto buffer = [] {
+        auto source = PackValues<P>::buffer;
+        ValueBuffer<
+            typename PackValues<P>::value_type, PackValues<P>::arity
+        > rv;
+        typename PackValues<P>::value_type accumulator = 0;
+        for(std::size_t i = 0; i < source.count; ++i) {
+            if(Inclusive) { accumulator += source.values[i]; }
+            rv.push(accumulator);
+            if(!Inclusive) { accumulator += source.values[i]; }
+        }
+        return rv;
+    }();
+};
+
+}
+
+/// \brief The pack values as a \c std::array
+template<typename P>
+constexpr auto Array_v = detail::PackValues<P>::array;
+
+template<std::size_t Index, typename P>
+struct ValueAtIndex {
+    static_assert(Index < detail::PackValues<P>::arity, "Index out of range");
+    constexpr static auto value = detail::PackValues<P>::buffer.values[Index];
+};
+
+template<std::size_t Index, typename P>
+constexpr auto ValueAtIndex_v = ValueAtIndex<Index, P>::value;
+
+/// \brief The elements in the positions [Begin, End)
+template<typename P, std::size_t Begin, std::size_t End>
+using Slice_t =
+    typename detail::Materialize<
+        detail::SliceComputation<P, Begin, End>
+    >::type;
+
+template<typename P>
+using Reverse_t =
+    typename detail::Materialize<detail::ReverseComputation<P>>::type;
+
+/// \note all the packs must have the same value type
+template<typename P, typename... Ps>
+using ConcatValues_t =
+    typename detail::Materialize<detail::ConcatComputation<P, Ps...>>::type;
+
+/// \brief Ascending order
+template<typename P>
+using Sort_t = typename detail::Materialize<detail::SortComputation<P>>::type;
+
+/// \brief Only the first occurrence of each value, in the original order
+template<typename P>
+using UniqueValues_t =
+    typename detail::Materialize<detail::UniqueComputation<P>>::type;
+
+/// \brief The first occurrence of each element, in the original order: of
+/// the values of an \c IndexPack, as \c UniqueValues_t, and of the types of
+/// a \c Pack with \c PackAlgorithms.h
+template<typename P>
+struct Unique;
+
+template<typename T, T... vs>
+struct Unique<IndexPack<T, vs...>> {
+    using type = UniqueValues_t<IndexPack<T, vs...>>;
+};
+
+template<typename P>
+using Unique_t = typename Unique<P>::type;
+
+/// \brief Element \c i is the sum of elements 0 to \c i
+template<typename P>
+using InclusiveScan_t =
+    typename detail::Materialize<detail::ScanComputation<P, true>>::type;
+
+/// \brief Element \c i is the sum of elements 0 to \c i - 1, suitable for
+/// converting sizes into offsets
+template<typename P>
+using ExclusiveScan_t =
+    typename detail::Materialize<detail::ScanComputation<P, false>>::type;
+
+/// \brief Position of the first element equal to \c v, the arity if none
+template<typename P, typename detail::PackValues<P>::value_type v>
+constexpr std::size_t Find_v = [] {
+    auto source = detail::PackValues<P>::buffer;
+    std::size_t i = 0;
+    while(i < source.count && source.values[i] != v) { ++i; }
+    return i;
+}();
+
+template<typename P, typename detail::PackValues<P>::value_type v>
+constexpr bool ContainsValue_v = Find_v<P, v> < P::arity;
+
+/// \brief Position of the first element not less than \c v, the pack must be
+/// sorted
+template<typename P, typename detail::PackValues<P>::value_type v>
+constexpr std::size_t LowerBound_v = [] {
+    auto source = detail::PackValues<P>::buffer;
+    std::size_t low = 0, high = source.count;
+    while(low < high) {
+        auto middle = low + (high - low) / 2;
+        if(source.values[middle] < v) { low = middle + 1; }
+        else { high = middle; }
+    }
+    return low;
+}();
+
+}
+
+#endif
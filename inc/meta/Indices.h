@@ -2,18 +2,108 @@
 
 #include "meta/IndexPack.h"
 
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#include <utility>
+#endif
+
 namespace meta {
 
-template<unsigned long count, unsigned long... indices>
-struct Indices_impl {
-    using type = typename Indices_impl<count - 1, count, indices...>::type;
+namespace detail {
+
+/// \brief Turns <tt>IndexPack<T, 0 .. n - 1></tt> into
+/// <tt>IndexPack<T, 0 .. 2n - 1></tt>, plus <tt>2n</tt> if \c Odd
+template<bool Odd, typename> struct DoubleIota;
+
+template<typename T, T... vs>
+struct DoubleIota<false, IndexPack<T, vs...>> {
+    using type = IndexPack<T, vs..., (T(sizeof...(vs)) + vs)...>;
+};
+
+template<typename T, T... vs>
+struct DoubleIota<true, IndexPack<T, vs...>> {
+    using type =
+        IndexPack<T, vs..., (T(sizeof...(vs)) + vs)..., T(2 * sizeof...(vs))>;
+};
+
+/// \brief Portable generator of <tt>IndexPack<T, 0 .. Count - 1></tt> with
+/// instantiation depth of log2(Count)
+template<typename T, std::size_t Count>
+struct Iota {
+    using type =
+        typename DoubleIota<Count % 2, typename Iota<T, Count / 2>::type>::type;
+};
+
+template<typename T>
+struct Iota<T, 0> {
+    using type = IndexPack<T>;
+};
+
+#if defined(__has_builtin)
+#if __has_builtin(__make_integer_seq)
+#define ZOO_META_MAKE_INTEGER_SEQ
+#elif __has_builtin(__integer_pack)
+#define ZOO_META_INTEGER_PACK
+#endif
+#endif
+
+#if defined(ZOO_META_MAKE_INTEGER_SEQ)
+template<typename T, T Count>
+using MakeIota = __make_integer_seq<IndexPack, T, Count>;
+#elif defined(ZOO_META_INTEGER_PACK)
+template<typename T, T Count>
+using MakeIota = IndexPack<T, __integer_pack(Count)...>;
+#else
+template<typename T, T Count>
+using MakeIota = typename Iota<T, std::size_t(Count)>::type;
+#endif
+
+#undef ZOO_META_MAKE_INTEGER_SEQ
+#undef ZOO_META_INTEGER_PACK
+
+template<typename, typename T, T Offset, T Stride>
+struct Affine;
+
+template<typename T, T... vs, T Offset, T Stride>
+struct Affine<IndexPack<T, vs...>, T, Offset, Stride> {
+    using type = IndexPack<T, T(Offset + vs * Stride)...>;
+};
+
+}
+
+/// \brief <tt>IndexPack<T, Offset, Offset + Stride, ...></tt> of \c Count
+/// elements, the analogous of \c std::make_integer_sequence
+/// \note Uses the compiler intrinsic when available, doubling otherwise, thus
+/// at most logarithmic instantiation depth
+template<typename T, T Count, T Offset = T(0), T Stride = T(1)>
+using MakeIndexPack =
+    typename detail::Affine<
+        detail::MakeIota<T, Count>, T, Offset, Stride
+    >::type;
+
+/// \brief <tt>IndexPack<unsigned long, 0, 1, ... count></tt>, notice that
+/// \c count itself is included
+template<unsigned long count>
+using Indices = MakeIndexPack<unsigned long, count + 1>;
+
+template<typename> struct ToIntegerSequence;
+
+template<typename T, T... vs>
+struct ToIntegerSequence<IndexPack<T, vs...>> {
+    using type = std::integer_sequence<T, vs...>;
 };
 
-template<unsigned long... indices>
-struct Indices_impl<0, indices...> {
-    using type = IndexPack<unsigned long, 0, indices...>;
+template<typename P>
+using ToIntegerSequence_t = typename ToIntegerSequence<P>::type;
+
+template<typename> struct FromIntegerSequence;
+
+template<typename T, T... vs>
+struct FromIntegerSequence<std::integer_sequence<T, vs...>> {
+    using type = IndexPack<T, vs...>;
 };
 
-template<unsigned long count> using Indices = typename Indices_impl<count>::type;
+template<typename S>
+using FromIntegerSequence_t = typename FromIntegerSequence<S>::type;
 
 }
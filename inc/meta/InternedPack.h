@@ -0,0 +1,39 @@
+#ifndef ZOO_META_INTERNED_PACK
+#define ZOO_META_INTERNED_PACK
+
+#include <meta/Pack.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <type_traits>
+#endif
+
+namespace meta {
+
+/// \brief Base of a named tag that stands in for a \c Pack, so that the
+/// symbols of the templates instantiated on it mention the short tag instead
+/// of the whole list of types:
+///
+/// <tt>struct Messages: Interned<Pack<...>> {};</tt>
+///
+/// \c PackIndexer accepts such tags directly
+template<typename P>
+struct Interned {
+    using interned_pack_t = P;
+};
+
+template<typename T, typename = void>
+struct Uninterned {
+    using type = T;
+};
+
+template<typename T>
+struct Uninterned<T, std::void_t<typename T::interned_pack_t>> {
+    using type = typename T::interned_pack_t;
+};
+
+template<typename T>
+using Uninterned_t = typename Uninterned<T>::type;
+
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef ZOO_META_LAYOUT_HASH
+#define ZOO_META_LAYOUT_HASH
+
+#include <meta/Pack.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#include <cstdint>
+#endif
+
+namespace meta {
+namespace detail {
+
+inline constexpr std::uint64_t FnvOffset = 14695981039346656037ull;
+
+constexpr std::uint64_t fnv1a(std::uint64_t hash, std::uint64_t value) {
+    for(auto i = 0; i < 8; ++i) {
+        hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t stringHash(const char *s) {
+    auto hash = FnvOffset;
+    for(; *s; ++s) {
+        hash = (hash ^ static_cast<unsigned char>(*s)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/// \brief Hash of the spelling of \c T by the compiler
+template<typename T>
+constexpr std::uint64_t typeNameHash() {
+    return stringHash(__PRETTY_FUNCTION__);
+}
+
+}
+
+/// \brief A data member in a \c LayoutFields declaration: its type, offset and
+/// the hash of its name, spelled by \c ZOO_META_FIELD
+template<typename Member, std::size_t Offset, std::uint64_t Name>
+struct Field {};
+
+/// \brief The data members of \c T its \c LayoutHash covers, a \c Pack of
+/// \c Field in declaration order; none unless specialized, then reordering
+/// members of the same size goes unnoticed
+template<typename T>
+struct LayoutFields {
+    using type = Pack<>;
+};
+
+#define ZOO_META_FIELD(Class, member) \
+    ::meta::Field< \
+        decltype(Class::member), offsetof(Class, member), \
+        ::meta::detail::stringHash(#member) \
+    >
+
+template<typename P>
+struct LayoutHash;
+
+namespace detail {
+
+template<typename T, typename Fields = typename LayoutFields<T>::type>
+struct FieldsHash;
+
+template<
+    typename T, typename... Ms, std::size_t... Offsets, std::uint64_t... Names
+>
+struct FieldsHash<T, Pack<Field<Ms, Offsets, Names>...>> {
+    /// \brief the members are hashed as message spaces of their own, thus
+    /// with their declared fields too
+    constexpr static std::uint64_t hash(std::uint64_t hash) {
+        std::uint64_t parts[][3] = {
+            { LayoutHash<Pack<Ms>>::value, Offsets, Names }..., { 0, 0, 0 }
+        };
+        for(auto &part: parts) {
+            for(auto v: part) { hash = fnv1a(hash, v); }
+        }
+        return hash;
+    }
+};
+
+}
+
+/// \brief Fingerprint of a message space: the names, sizes and alignments of
+/// the types of the \c Pack in their order, and the members declared in
+/// their \c LayoutFields, to check that the two sides of a shared memory
+/// channel or the writer of a file agree with the reader
+/// \note the names are as spelled by the compiler, both sides must be built
+/// with the same compiler family
+template<typename... Ts>
+struct LayoutHash<Pack<Ts...>> {
+    constexpr static std::uint64_t value = [] {
+        auto hash = detail::fnv1a(detail::FnvOffset, sizeof...(Ts));
+        std::uint64_t parts[][3] = {
+            { detail::typeNameHash<Ts>(), sizeof(Ts), alignof(Ts) }...,
+            { 0, 0, 0 }
+        };
+        for(auto &part: parts) {
+            for(auto v: part) { hash = detail::fnv1a(hash, v); }
+        }
+        ((hash = detail::FieldsHash<Ts>::hash(hash)), ...);
+        return hash;
+    }();
+};
+
+template<typename P>
+constexpr std::uint64_t LayoutHash_v = LayoutHash<P>::value;
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef ZOO_META_LOAD_SHEDDER
+#define ZOO_META_LOAD_SHEDDER
+
+#include <meta/CacheLine.h>
+#include <meta/Conflator.h>
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#endif
+
+namespace meta {
+
+/// \brief What the admission stage does with a message
+enum class Admission: std::uint8_t {
+    Deliver, ///< to the consumer
+    Conflate, ///< into the pending slot of its key and type
+    Drop
+};
+
+namespace detail {
+
+template<
+    typename P, template<typename> class Priority,
+    template<typename> class Conflated
+>
+struct SheddingTable;
+
+template<
+    typename... Ts, template<typename> class Priority,
+    template<typename> class Conflated
+>
+struct SheddingTable<Pack<Ts...>, Priority, Conflated> {
+    constexpr static std::size_t Size = sizeof...(Ts);
+    constexpr static std::size_t Levels =
+        std::max({ std::size_t(0), std::size_t(Priority<Ts>::value)... }) + 1;
+
+    constexpr static auto make() {
+        constexpr std::size_t priorities[] = { Priority<Ts>::value... };
+        constexpr bool conflated[] = { Conflated<Ts>::value... };
+        std::array<Admission, Levels * Size> rv = {};
+        for(std::size_t level = 0; level < Levels; ++level) {
+            for(std::size_t i = 0; i < Size; ++i) {
+                auto shed = priorities[i] && priorities[i] <= level;
+                rv[level * Size + i] =
+                    !shed ? Admission::Deliver :
+                    conflated[i] ? Admission::Conflate : Admission::Drop;
+            }
+        }
+        return rv;
+    }
+
+    /// \brief a row of \c Size per level
+    alignas(CacheLineSize) constexpr static auto actions = make();
+};
+
+}
+
+/// \brief Admission stage in front of the dispatch of the types of \c P, that
+/// sheds messages as the backlog of the consumer grows
+///
+/// The backlog sets a level, the count of \c Thresholds it reached.  A type
+/// \c T is shed from level <tt>Priority<T>::value</tt>, never if 0: conflated
+/// per key if <tt>Conflated<T>::value</tt>, else dropped.  The action of every
+/// level and index is a compile time table, \c offer loads it from the row of
+/// the current level without branching on the type.  When the level goes
+/// down, the conflated messages are delivered before the messages admitted
+/// at the lower level, thus no stale message overtakes a newer one.  Messages
+/// are delivered to a \c Sink_t
+/// \note shedding is monotonic: a type shed at a level is shed at all the
+/// levels above
+template<
+    typename P, template<typename> class Priority,
+    template<typename> class Conflated
+>
+class LoadShedder {
+    using Table = detail::SheddingTable<P, Priority, Conflated>;
+
+public:
+    constexpr static std::size_t Levels = Table::Levels;
+    /// \brief the backlogs from which each level above 0 starts
+    using Thresholds = std::array<std::size_t, Levels - 1>;
+
+private:
+    Conflator<P, Conflated> conflator_;
+    Thresholds thresholds_;
+    std::size_t level_ = 0;
+    const Admission *row_ = Table::actions.data();
+    std::array<std::uint64_t, 3> counts_ = {}; ///< by \c Admission
+
+public:
+    /// \param keys the bound of the keys of the conflated messages
+    /// \throw std::invalid_argument if the thresholds decrease
+    LoadShedder(const Thresholds &thresholds, std::size_t keys):
+        conflator_(keys), thresholds_(thresholds)
+    {
+        if(!std::is_sorted(thresholds_.begin(), thresholds_.end())) {
+            throw std::invalid_argument("Decreasing shedding thresholds");
+        }
+    }
+
+    template<typename Message>
+    constexpr static Admission action(std::size_t level) {
+        return Table::actions[level * Table::Size + IndexOf_v<Message, P>];
+    }
+
+    /// \brief Sets the level for the backlog, delivering the conflated
+    /// messages if it goes down
+    template<typename Sink>
+    void backlog(std::size_t size, Sink &&sink) {
+        std::size_t level = 0;
+        for(auto t: thresholds_) { level += t <= size; }
+        if(level < level_) { conflator_.drain(sink); }
+        level_ = level;
+        row_ = Table::actions.data() + level * Table::Size;
+    }
+
+    /// \param index of the message in \c P, it selects the action in the row
+    template<typename Sink>
+    Admission offer(
+        std::size_t key, const void *message, std::size_t index, Sink &&sink
+    ) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        assert(index < Table::Size);
+        auto rv = row_[index];
+        ++counts_[std::size_t(rv)];
+        if(Admission::Deliver == rv) {
+            sink(message, index);
+        } else if(Admission::Conflate == rv) {
+            conflator_.push(key, message, index, sink);
+        }
+        return rv;
+    }
+
+    /// \brief Delivers the conflated messages pending
+    template<typename Sink>
+    void drain(Sink &&sink) { conflator_.drain(sink); }
+
+    /// \brief Delivers the conflated messages pending for \c key, ahead of a
+    /// message that must not overtake them
+    template<typename Sink>
+    void flush(std::size_t key, Sink &&sink) { conflator_.flush(key, sink); }
+
+    std::size_t level() const noexcept { return level_; }
+
+    std::uint64_t count(Admission a) const noexcept {
+        return counts_[std::size_t(a)];
+    }
+};
+
+}
+
+#endif
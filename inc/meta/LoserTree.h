@@ -0,0 +1,122 @@
+#ifndef ZOO_META_LOSER_TREE
+#define ZOO_META_LOSER_TREE
+
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace meta {
+
+/// \brief What a merge source hands out: a message in place, in the memory of
+/// the source, with its index in the message \c Pack
+struct MergeEntry {
+    std::uint64_t timestamp;
+    std::size_t index;
+    const void *message;
+};
+
+/// \brief Timestamp ordered merge of k sources through a tournament tree of
+/// losers: replacing the winner replays only its path to the root, about
+/// log2(k) comparisons against the losers stored on it
+///
+/// A \c Source is anything with
+/// <tt>std::size_t fill(MergeEntry *destination, std::size_t capacity)</tt>,
+/// returning 0 when exhausted; it is pulled \c Batch entries at a time, the
+/// messages they point to must remain valid until the next \c fill.  The
+/// merged messages go to a \c Sink_t without being copied.  Equal timestamps
+/// are delivered in source order
+template<typename Source, std::size_t Batch = 64>
+class LoserTree {
+    constexpr static auto Exhausted = std::numeric_limits<std::uint64_t>::max();
+
+    struct Input {
+        Source *source;
+        std::size_t cursor = 0, count = 0;
+        MergeEntry entries[Batch];
+    };
+
+    std::vector<Input> inputs_;
+    std::size_t leaves_;
+    /// \brief the key of each leaf, padding leaves are exhausted
+    std::vector<std::uint64_t> keys_;
+    /// \brief \c tree_[0] is the winner, the other nodes the losers
+    std::vector<std::size_t> tree_;
+
+    bool less(std::size_t a, std::size_t b) const noexcept {
+        return keys_[a] < keys_[b] || (keys_[a] == keys_[b] && a < b);
+    }
+
+    void refill(std::size_t i) {
+        auto &input = inputs_[i];
+        input.cursor = 0;
+        input.count = input.source->fill(input.entries, Batch);
+        keys_[i] = input.count ? input.entries[0].timestamp : Exhausted;
+    }
+
+public:
+    template<typename Sources>
+    explicit LoserTree(Sources &sources) {
+        for(auto &s: sources) {
+            inputs_.emplace_back();
+            inputs_.back().source = &s;
+        }
+        leaves_ = 1;
+        while(leaves_ < inputs_.size()) { leaves_ *= 2; }
+        keys_.assign(leaves_, Exhausted);
+        tree_.assign(leaves_, 0);
+        for(std::size_t i = 0; i < inputs_.size(); ++i) { refill(i); }
+        // winners of each node, bottom up; the losers stay in the tree
+        std::vector<std::size_t> winners(2 * leaves_);
+        for(std::size_t i = 0; i < leaves_; ++i) { winners[leaves_ + i] = i; }
+        for(auto node = leaves_; --node; ) {
+            auto l = winners[2 * node], r = winners[2 * node + 1];
+            auto leftWins = less(l, r);
+            winners[node] = leftWins ? l : r;
+            tree_[node] = leftWins ? r : l;
+        }
+        tree_[0] = winners[1];
+    }
+
+    LoserTree(const LoserTree &) = delete;
+    LoserTree &operator=(const LoserTree &) = delete;
+
+    bool empty() const noexcept { return Exhausted == keys_[tree_[0]]; }
+
+    /// \brief Delivers up to \c limit messages
+    /// \return how many were delivered, less than \c limit only when all of
+    /// the sources are exhausted
+    template<typename Sink>
+    std::size_t merge(Sink &&sink, std::size_t limit = ~std::size_t(0)) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        std::size_t delivered = 0;
+        for(; delivered < limit; ++delivered) {
+            auto winner = tree_[0];
+            if(Exhausted == keys_[winner]) { break; }
+            auto &input = inputs_[winner];
+            auto &entry = input.entries[input.cursor];
+            sink(entry.message, entry.index);
+            if(++input.cursor < input.count) {
+                keys_[winner] = input.entries[input.cursor].timestamp;
+            } else {
+                refill(winner);
+            }
+            for(auto node = (leaves_ + winner) / 2; node; node /= 2) {
+                if(less(tree_[node], winner)) {
+                    std::swap(tree_[node], winner);
+                }
+            }
+            tree_[0] = winner;
+        }
+        return delivered;
+    }
+};
+
+}
+
+#endif
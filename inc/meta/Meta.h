@@ -0,0 +1,54 @@
+#ifndef ZOO_META_META
+#define ZOO_META_META
+
+/// \file Meta.h
+/// Umbrella header of the library, suitable to be precompiled, see the
+/// README.
+/// \c ShardedInstantiatorShard.h is deliberately excluded, since it must be
+/// included only by the shard translation units.
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#endif
+
+#include <meta/Pack.h>
+#include <meta/IndexPack.h>
+#include <meta/Indices.h>
+#include <meta/IndexPackAlgorithms.h>
+#include <meta/TypeAtIndex.h>
+#include <meta/IndexOf.h>
+#include <meta/TypeMap.h>
+#include <meta/PackAlgorithms.h>
+#include <meta/PackUnion.h>
+#include <meta/InternedPack.h>
+#include <meta/PackIndexer.h>
+#include <meta/InplaceType.h>
+#include <meta/NotBasedOn.h>
+#include <meta/Instantiator.h>
+#include <meta/ShardedInstantiator.h>
+#include <meta/StatefulInstantiator.h>
+#include <meta/Table.h>
+#include <meta/TupleVisit.h>
+#include <meta/Seqlock.h>
+#include <meta/Sink.h>
+#include <meta/Conflator.h>
+#include <meta/FeedArbiter.h>
+#include <meta/LoserTree.h>
+#include <meta/PayloadLayout.h>
+#include <meta/TimerWheel.h>
+#include <meta/LayoutHash.h>
+#include <meta/SpscRing.h>
+#include <meta/SharedRing.h>
+#include <meta/MulticastRing.h>
+#include <meta/EpochReclaimer.h>
+#include <meta/AsyncLogger.h>
+#include <meta/OutboundWriter.h>
+#include <meta/StateSnapshot.h>
+#include <meta/PluginTable.h>
+#include <meta/LoadShedder.h>
+#include <meta/SupersedingShedder.h>
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef ZOO_META_MULTICAST_RING
+#define ZOO_META_MULTICAST_RING
+
+#include <meta/CacheLine.h>
+#include <meta/IndexOf.h>
+#include <meta/PayloadLayout.h>
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#endif
+
+namespace meta {
+
+/// \brief Single producer broadcast ring of slots holding any type of \c P,
+/// in the manner of the Disruptor: every consumer sees every message, in
+/// place, and the consumers that depend on others see a message only after
+/// them
+///
+/// Progress is only sequence numbers: the producer publishes a cursor, each
+/// consumer publishes how many it consumed.  A consumer may go up to the
+/// cursor and to the sequences of the consumers it depends on, declared at
+/// construction; the producer may reuse a slot once all the consumers went
+/// past it.  Both sides work in batches and pay the synchronization once per
+/// batch
+/// \note all the waiting is done by the callers, \c tryClaim and \c poll
+/// never block
+template<typename P, std::size_t Capacity>
+class MulticastRing {
+    static_assert(0 == (Capacity & (Capacity - 1)), "Power of two capacity");
+
+    using Layout = detail::PayloadLayout<P>;
+
+    struct alignas(Layout::alignment) Slot {
+        unsigned char bytes[Layout::size];
+        std::size_t index;
+    };
+
+    struct alignas(CacheLineSize) Sequence {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    Sequence cursor_; ///< published by the producer
+    std::unique_ptr<Sequence[]> consumed_;
+    std::vector<std::vector<std::size_t>> dependencies_;
+    std::size_t consumers_;
+
+    // producer side
+    std::uint64_t claimed_ = 0, limit_ = 0, gate_ = 0;
+
+public:
+    /// \param dependencies element \c i lists the consumers that must see
+    /// a message before consumer \c i; their count is the consumer count
+    explicit MulticastRing(std::vector<std::vector<std::size_t>> dependencies):
+        slots_(new Slot[Capacity]),
+        consumed_(new Sequence[dependencies.size()]),
+        dependencies_(std::move(dependencies)),
+        consumers_(dependencies_.size())
+    {
+        for(std::size_t c = 0; c < consumers_; ++c) {
+            for(auto d: dependencies_[c]) {
+                // a consumer can only depend on earlier ones, no cycles
+                if(c <= d) {
+                    throw std::invalid_argument("Bad consumer dependency");
+                }
+            }
+        }
+    }
+
+    MulticastRing(const MulticastRing &) = delete;
+    MulticastRing &operator=(const MulticastRing &) = delete;
+
+    /// \brief Reserves \c count slots for the producer, from the next one
+    /// \c write fills
+    /// \return false when the slowest consumer is less than \c count slots
+    /// behind a full ring, always for more than \c Capacity
+    bool tryClaim(std::size_t count) noexcept {
+        if(Capacity < count) { return false; }
+        auto end = claimed_ + count;
+        if(gate_ + Capacity < end) {
+            auto slowest = end;
+            for(std::size_t c = 0; c < consumers_; ++c) {
+                auto v = consumed_[c].value.load(std::memory_order_acquire);
+                if(v < slowest) { slowest = v; }
+            }
+            gate_ = slowest;
+            if(gate_ + Capacity < end) { return false; }
+        }
+        limit_ = end;
+        return true;
+    }
+
+    /// \brief Writes the next claimed slot, not visible until \c publish
+    /// \pre a slot is claimed and not yet written, else a consumer may be
+    /// reading the slot
+    template<typename Message>
+    void write(const Message &m) noexcept {
+        assert(claimed_ < limit_);
+        auto &slot = slots_[claimed_++ & (Capacity - 1)];
+        std::memcpy(slot.bytes, &m, sizeof(m));
+        slot.index = IndexOf_v<Message, P>;
+    }
+
+    /// \brief Makes all of the written slots visible
+    void publish() noexcept {
+        cursor_.value.store(claimed_, std::memory_order_release);
+    }
+
+    /// \brief Delivers to consumer \c c up to \c batch messages to a
+    /// \c Sink_t, in place in the ring
+    template<typename Sink>
+    std::size_t poll(std::size_t c, Sink &&sink, std::size_t batch = Capacity) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        auto &own = consumed_[c].value;
+        auto next = own.load(std::memory_order_relaxed);
+        auto available = cursor_.value.load(std::memory_order_acquire);
+        for(auto d: dependencies_[c]) {
+            auto v = consumed_[d].value.load(std::memory_order_acquire);
+            if(v < available) { available = v; }
+        }
+        if(next + batch < available) { available = next + batch; }
+        for(auto s = next; s < available; ++s) {
+            auto &slot = slots_[s & (Capacity - 1)];
+            sink(static_cast<const void *>(slot.bytes), slot.index);
+        }
+        own.store(available, std::memory_order_release);
+        return std::size_t(available - next);
+    }
+
+    /// \brief how many messages consumer \c c went past
+    std::uint64_t consumed(std::size_t c) const noexcept {
+        return consumed_[c].value.load(std::memory_order_acquire);
+    }
+
+    std::uint64_t published() const noexcept {
+        return cursor_.value.load(std::memory_order_acquire);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef ZOO_META_OUTBOUND_WRITER
+#define ZOO_META_OUTBOUND_WRITER
+
+#include <meta/TypeMap.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+#include <sys/uio.h>
+#endif
+
+namespace meta {
+
+/// \brief Precedes each message on the wire, in host byte order
+struct WireHeader {
+    std::uint16_t length; ///< of the whole frame, header included
+    std::uint16_t id;
+};
+
+/// \brief Frames of the messages whose types are the keys of \c WireIds, a
+/// \c TypeMap to \c std::integral_constant wire ids, encoded back to back
+/// into a send buffer and written to a file descriptor in batches
+///
+/// The id and length of each frame are compile time constants of its type,
+/// thus encoding is two copies.  The buffer is a ring of blocks that a frame
+/// never straddles; a flush writes all of the filled blocks with one
+/// \c writev, and resumes after partial writes.  It happens when the bytes
+/// pending reach \c Thresholds::bytes, when \c poll finds the oldest pending
+/// frame older than \c Thresholds::delay, or when the ring is full
+/// \note a non blocking descriptor that would block leaves the bytes pending,
+/// a \c writev interrupted by a signal is retried
+template<typename WireIds>
+class OutboundWriter {
+    struct Block {
+        std::size_t used = 0, sent = 0;
+    };
+
+    int fd_;
+    std::size_t blockSize_, flushBytes_;
+    std::chrono::nanoseconds delay_;
+    std::vector<unsigned char> storage_;
+    std::vector<Block> blocks_;
+    std::vector<iovec> vectors_;
+    std::size_t head_ = 0; ///< the first block with bytes not sent
+    std::size_t tail_ = 0; ///< the block being filled
+    std::size_t pending_ = 0;
+    std::chrono::steady_clock::time_point oldest_;
+    std::uint64_t writes_ = 0;
+
+    std::size_t next(std::size_t block) const noexcept {
+        return block + 1 == blocks_.size() ? 0 : block + 1;
+    }
+
+    /// \brief the block to encode \c size bytes into, \c blocks_.size() if
+    /// the ring is full or the frame larger than a block
+    std::size_t room(std::size_t size) {
+        if(size <= blockSize_ - blocks_[tail_].used) { return tail_; }
+        if(blockSize_ < size) { return blocks_.size(); }
+        if(next(tail_) == head_) {
+            flush();
+            if(size <= blockSize_ - blocks_[tail_].used) { return tail_; }
+            if(next(tail_) == head_) { return blocks_.size(); }
+        }
+        return tail_ = next(tail_);
+    }
+
+public:
+    template<typename Message>
+    constexpr static std::size_t frameSize =
+        sizeof(WireHeader) + sizeof(Message);
+
+    struct Thresholds {
+        std::size_t bytes = 64 << 10;
+        std::chrono::nanoseconds delay = std::chrono::microseconds(20);
+    };
+
+    /// \throw std::invalid_argument if \c blocks is 0 or more than one
+    /// \c writev takes, \c IOV_MAX
+    OutboundWriter(
+        int fd, Thresholds thresholds,
+        std::size_t blockSize = 64 << 10, std::size_t blocks = 16
+    ):
+        fd_(fd), blockSize_(blockSize), flushBytes_(thresholds.bytes),
+        delay_(thresholds.delay)
+    {
+        if(!blocks || IOV_MAX < blocks) {
+            throw std::invalid_argument("Outbound blocks not in 1..IOV_MAX");
+        }
+        storage_.resize(blockSize * blocks);
+        blocks_.resize(blocks);
+        vectors_.resize(blocks);
+    }
+
+    explicit OutboundWriter(int fd): OutboundWriter(fd, Thresholds{}) {}
+
+    /// \return false if the ring is full and could not be flushed
+    template<typename Message>
+    bool encode(const Message &m) {
+        static_assert(std::is_trivially_copyable<Message>::value, "");
+        constexpr auto size = frameSize<Message>;
+        static_assert(size <= 0xFFFF, "The length is 16 bits");
+        static_assert(
+            std::uintmax_t(WireIds::template value<Message>) <= 0xFFFF,
+            "The id is 16 bits"
+        );
+        auto block = room(size);
+        if(blocks_.size() == block) { return false; }
+        if(!pending_) { oldest_ = std::chrono::steady_clock::now(); }
+        constexpr WireHeader header = {
+            std::uint16_t(size),
+            std::uint16_t(WireIds::template value<Message>)
+        };
+        auto at = storage_.data() + block * blockSize_ + blocks_[block].used;
+        std::memcpy(at, &header, sizeof(header));
+        std::memcpy(at + sizeof(header), &m, sizeof(m));
+        blocks_[block].used += size;
+        pending_ += size;
+        if(flushBytes_ <= pending_) { flush(); }
+        return true;
+    }
+
+    /// \brief Flushes if the oldest pending frame waited the delay
+    /// \return whether it flushed
+    bool poll() {
+        if(!pending_) { return false; }
+        if(std::chrono::steady_clock::now() - oldest_ < delay_) {
+            return false;
+        }
+        flush();
+        return true;
+    }
+
+    /// \brief Writes what the descriptor takes of the pending bytes
+    /// \return the bytes written
+    /// \throw std::system_error on errors other than would block
+    std::size_t flush() {
+        if(!pending_) { return 0; }
+        std::size_t count = 0;
+        for(auto b = head_; ; b = next(b)) {
+            auto &block = blocks_[b];
+            if(block.sent < block.used) {
+                vectors_[count++] = {
+                    storage_.data() + b * blockSize_ + block.sent,
+                    block.used - block.sent
+                };
+            }
+            if(b == tail_) { break; }
+        }
+        ssize_t written;
+        do {
+            written = ::writev(fd_, vectors_.data(), int(count));
+            ++writes_;
+        } while(written < 0 && EINTR == errno);
+        if(written < 0) {
+            if(EAGAIN == errno || EWOULDBLOCK == errno) { return 0; }
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+        pending_ -= std::size_t(written);
+        for(auto left = std::size_t(written); ; head_ = next(head_)) {
+            auto &block = blocks_[head_];
+            auto rest = block.used - block.sent;
+            if(left < rest) { block.sent += left; break; }
+            left -= rest;
+            block.used = block.sent = 0;
+            if(head_ == tail_) { break; }
+        }
+        return std::size_t(written);
+    }
+
+    std::size_t pending() const noexcept { return pending_; }
+    std::uint64_t writes() const noexcept { return writes_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef ZOO_META_PACK_ALGORITHMS
+#define ZOO_META_PACK_ALGORITHMS
+
+#include <meta/TypeAtIndex.h>
+#include <meta/IndexPackAlgorithms.h>
+#include <meta/LayoutHash.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#endif
+
+/// \file PackAlgorithms.h
+/// Type-list algorithms over \c Pack.  Element selection is done by computing
+/// the positions to keep as a \c constexpr array and then picking them with
+/// \c TypeAtIndex, which resolves by overload resolution; no algorithm here
+/// recurses once per element.
+
+namespace meta {
+
+template<typename T, typename P>
+struct Contains;
+
+template<typename T, typename... Ts>
+struct Contains<T, Pack<Ts...>>:
+    std::integral_constant<bool, (std::is_same<T, Ts>::value || ...)>
+{};
+
+template<typename T, typename P>
+constexpr bool Contains_v = Contains<T, P>::value;
+
+/// \brief <tt>Pack<T_is...></tt>, the elements at the given positions
+template<typename P, typename Positions>
+struct Select;
+
+template<typename... Ts, std::size_t... is>
+struct Select<Pack<Ts...>, IndexPack<std::size_t, is...>> {
+    using Indexed =
+        detail::IndexedTypes<MakeIndexPack<std::size_t, sizeof...(Ts)>, Ts...>;
+
+    // not TypeAtIndex_t, to not instantiate one template per position with
+    // all of the elements as arguments
+    using type =
+        Pack<
+            typename decltype(
+                detail::typeAtIndex<is>(static_cast<Indexed *>(nullptr))
+            )::type...
+        >;
+};
+
+template<typename P, typename Positions>
+using Select_t = typename Select<P, Positions>::type;
+
+namespace detail {
+
+template<typename PackOfPacks>
+struct ConcatPacks;
+
+template<>
+struct ConcatPacks<Pack<>> {
+    using type = Pack<>;
+};
+
+template<typename... Ts>
+struct ConcatPacks<Pack<Pack<Ts...>>> {
+    using type = Pack<Ts...>;
+};
+
+template<typename... Ts, typename... Us>
+struct ConcatPacks<Pack<Pack<Ts...>, Pack<Us...>>> {
+    using type = Pack<Ts..., Us...>;
+};
+
+/// \note splits in halves, logarithmic depth on the number of packs
+template<typename... Ps>
+struct ConcatPacks<Pack<Ps...>> {
+    constexpr static auto half = sizeof...(Ps) / 2;
+
+    using type =
+        typename ConcatPacks<Pack<
+            typename ConcatPacks<
+                Select_t<Pack<Ps...>, MakeIndexPack<std::size_t, half>>
+            >::type,
+            typename ConcatPacks<
+                Select_t<
+                    Pack<Ps...>,
+                    MakeIndexPack<std::size_t, sizeof...(Ps) - half, half>
+                >
+            >::type
+        >>::type;
+};
+
+/// \brief Converts the \c buffer of flags of \c Flags into the positions set
+template<typename Flags>
+struct FlaggedPositions {
+    using value_type = std::size_t;
+    constexpr static auto buffer = [] {
+        auto flags = Flags::buffer;
+        ValueBuffer<
+            std::size_t, std::extent<decltype(Flags::buffer.values)>::value
+        > rv;
+        for(std::size_t i = 0; i < flags.count; ++i) {
+            if(flags.values[i]) { rv.push(i); }
+        }
+        return rv;
+    }();
+};
+
+template<template<typename> class Predicate, typename P>
+struct FilterFlags;
+
+template<template<typename> class Predicate, typename... Ts>
+struct FilterFlags<Predicate, Pack<Ts...>> {
+    constexpr static ValueBuffer<bool, sizeof...(Ts)> buffer = {
+        { bool(Predicate<Ts>::value)... }, sizeof...(Ts)
+    };
+};
+
+template<typename T>
+struct TypeTag {
+    constexpr static char tag = 0;
+};
+
+template<typename P>
+struct UniqueFlags;
+
+/// \note sorts by \c typeNameHash, thus O(N log N) constexpr steps rather
+/// than comparing every pair; the addresses of distinct objects compare
+/// unequal in constant expressions, they tell apart the types of a run of
+/// equal hashes
+template<typename... Ts>
+struct UniqueFlags<Pack<Ts...>> {
+    constexpr static auto buffer = [] {
+        // the copies are because GCC subscripts arrays initialized by a pack
+        // expansion several times slower
+        constexpr auto N = sizeof...(Ts);
+        const void *initializer[N ? N : 1] = { &TypeTag<Ts>::tag... };
+        const void *ids[N ? N : 1] = {};
+        for(std::size_t i = 0; i < N; ++i) { ids[i] = initializer[i]; }
+        ValueBuffer<std::uint64_t, N> hashes = {
+            { typeNameHash<Ts>()... }, N
+        };
+        auto order = stableOrder(hashes);
+        ValueBuffer<bool, N> rv;
+        rv.count = N;
+        for(std::size_t run = 0, end = 0; run < N; run = end) {
+            auto hash = hashes.values[order.values[run]];
+            end = run;
+            while(end < N && hash == hashes.values[order.values[end]]) {
+                ++end;
+            }
+            // in the original order within the run, as the sort is stable;
+            // the first ones of each type are moved to the front
+            auto firsts = run;
+            for(auto i = run; i < end; ++i) {
+                auto current = order.values[i];
+                auto first = true;
+                for(auto j = run; j < firsts; ++j) {
+                    if(ids[order.values[j]] == ids[current]) {
+                        first = false;
+                        break;
+                    }
+                }
+                rv.values[current] = first;
+                if(first) { order.values[firsts++] = current; }
+            }
+        }
+        return rv;
+    }();
+};
+
+template<typename Flags, typename P>
+using FlaggedSelection_t =
+    Select_t<P, typename Materialize<FlaggedPositions<Flags>>::type>;
+
+template<template<typename> class Key, bool Descending, typename P>
+struct SortByComputation;
+
+template<template<typename> class Key, bool Descending, typename... Ts>
+struct SortByComputation<Key, Descending, Pack<Ts...>> {
+    using value_type = std::size_t;
+    constexpr static auto buffer = [] {
+        ValueBuffer<long long, sizeof...(Ts)> keys = {
+            { (Descending ? -1 : 1) * (long long)(Key<Ts>::value)... },
+            sizeof...(Ts)
+        };
+        return stableOrder(keys);
+    }();
+};
+
+}
+
+/// \brief Concatenation of any number of \c Pack
+template<typename... Ps>
+using Concat_t = typename detail::ConcatPacks<Pack<Ps...>>::type;
+
+/// \brief The elements \c T for which <tt>Predicate<T>::value</tt>
+template<template<typename> class Predicate, typename P>
+using Filter_t =
+    detail::FlaggedSelection_t<detail::FilterFlags<Predicate, P>, P>;
+
+template<template<typename> class Template, typename P>
+struct Transform;
+
+template<template<typename> class Template, typename... Ts>
+struct Transform<Template, Pack<Ts...>> {
+    using type = Pack<Template<Ts>...>;
+};
+
+template<template<typename> class Template, typename P>
+using Transform_t = typename Transform<Template, P>::type;
+
+/// \brief <tt>Pack<Template<I>...></tt> for the indices \c I of the given
+/// \c IndexPack, such as the ones produced by \c MakeIndexPack
+template<template<std::size_t> class Template, typename Indices>
+struct Generate;
+
+template<template<std::size_t> class Template, std::size_t... is>
+struct Generate<Template, IndexPack<std::size_t, is...>> {
+    using type = Pack<Template<is>...>;
+};
+
+template<template<std::size_t> class Template, typename Indices>
+using Generate_t = typename Generate<Template, Indices>::type;
+
+/// \brief The first occurrence of each type, in the original order
+template<typename... Ts>
+struct Unique<Pack<Ts...>> {
+    using type =
+        detail::FlaggedSelection_t<
+            detail::UniqueFlags<Pack<Ts...>>, Pack<Ts...>
+        >;
+};
+
+template<typename T>
+using SizeOf = std::integral_constant<std::size_t, sizeof(T)>;
+
+template<typename T>
+using AlignOf = std::integral_constant<std::size_t, alignof(T)>;
+
+/// \brief Stable sort on <tt>Key<T>::value</tt>, for example, \c AlignOf in
+/// descending order minimizes padding
+template<template<typename> class Key, typename P, bool Descending = false>
+using SortBy_t =
+    Select_t<
+        P,
+        typename detail::Materialize<
+            detail::SortByComputation<Key, Descending, P>
+        >::type
+    >;
+
+}
+
+#endif
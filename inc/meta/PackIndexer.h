@@ -2,13 +2,16 @@
 #define ZOO_META_PACK_INSTANTIATOR
 
 #include <meta/TypeAtIndex.h>
+#include <meta/InternedPack.h>
 
 namespace meta {
 
+/// \note \c TypeArray may be an \c Interned tag
 template<template<typename> class Executor, typename... TypeArray>
 struct PackIndexer {
     template<std::size_t Index>
-    using Internal = Executor<TypeAtIndex_t<Index, TypeArray...>>;
+    using Internal =
+        Executor<TypeAtIndex_t<Index, Uninterned_t<TypeArray>...>>;
 };
 
 }
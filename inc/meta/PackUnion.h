@@ -0,0 +1,61 @@
+#ifndef ZOO_META_PACK_UNION
+#define ZOO_META_PACK_UNION
+
+#include <meta/IndexOf.h>
+#include <meta/PackAlgorithms.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cstddef>
+#endif
+
+namespace meta {
+namespace detail {
+
+template<typename Unified, typename Venue>
+struct RemapTable;
+
+template<typename... Us, typename... Ts>
+struct RemapTable<Pack<Us...>, Pack<Ts...>> {
+    using Indexed =
+        IndexedTypes<MakeIndexPack<std::size_t, sizeof...(Us)>, Us...>;
+
+    constexpr static std::array<std::size_t, sizeof...(Ts)> value = {{
+        decltype(indexOf<Ts>(static_cast<Indexed *>(nullptr)))::value...
+    }};
+};
+
+}
+
+/// \brief Merges the message spaces of several venues, each a \c Pack, into
+/// the deduplicated \c Pack \c type, with tables from the indices of each
+/// venue to the indices of \c type
+///
+/// A venue dispatch through \c Remapped jumps directly into the handlers of
+/// the unified space: its table entries are the very same functions, thus
+/// there is neither a second lookup nor handler instantiations per venue
+template<typename... Venues>
+struct PackUnion {
+    using type = Unique_t<Concat_t<Venues...>>;
+
+    template<std::size_t Venue>
+    using venue_t = TypeAtIndex_t<Venue, Venues...>;
+
+    /// \brief <tt>remap<V>[i]</tt> is the index in \c type of the element
+    /// \c i of the venue \c V
+    template<std::size_t Venue>
+    constexpr static auto remap =
+        detail::RemapTable<type, venue_t<Venue>>::value;
+
+    /// \brief Adapts a \c UserTemplate of unified indices, such as
+    /// <tt>PackIndexer<Executor, type>::Internal</tt>, to the venue indices
+    template<template<std::size_t> class UserTemplate, std::size_t Venue>
+    struct Remapped {
+        template<std::size_t Index>
+        using Internal = UserTemplate<remap<Venue>[Index]>;
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef ZOO_META_PAYLOAD_LAYOUT
+#define ZOO_META_PAYLOAD_LAYOUT
+
+#include <meta/Pack.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#endif
+
+namespace meta {
+namespace detail {
+
+/// \brief Size and alignment of storage for any of the types of the \c Pack,
+/// kept as bytes
+template<typename P>
+struct PayloadLayout;
+
+template<typename... Ts>
+struct PayloadLayout<Pack<Ts...>> {
+    static_assert(
+        (std::is_trivially_copyable<Ts>::value && ...),
+        "Payloads are stored as bytes"
+    );
+
+    constexpr static std::size_t size =
+        std::max({ std::size_t(1), sizeof(Ts)... });
+    constexpr static std::size_t alignment =
+        std::max({ alignof(std::uint64_t), alignof(Ts)... });
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef ZOO_META_PLUGIN_TABLE
+#define ZOO_META_PLUGIN_TABLE
+
+#include <meta/LayoutHash.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <dlfcn.h>
+#endif
+
+namespace meta {
+
+/// \brief What a shared object exports: a handler per type of a \c Pack, by
+/// index, with the layout hashes of the \c Pack and of the context the
+/// handlers receive, to be checked by the host
+struct PluginTable {
+    constexpr static std::uint32_t Version = 1;
+
+    using handler_t = void (*)(void *context, const void *message);
+
+    std::uint32_t version;
+    std::uint32_t size;
+    std::uint64_t layoutHash, contextHash;
+    const handler_t *handlers; ///< \c nullptr for the types not handled
+};
+
+namespace detail {
+
+template<typename H, typename = void>
+struct Handles: std::false_type {};
+
+template<typename H>
+struct Handles<H, std::void_t<decltype(&H::execute)>>: std::true_type {};
+
+template<template<typename> class Handler, typename Context, typename T>
+struct PluginEntry {
+    static void execute(void *context, const void *message) {
+        Handler<T>::execute(
+            *static_cast<Context *>(context), *static_cast<const T *>(message)
+        );
+    }
+
+    constexpr static PluginTable::handler_t value = [] {
+        if constexpr(Handles<Handler<T>>::value) {
+            return &execute;
+        } else {
+            return PluginTable::handler_t(nullptr);
+        }
+    }();
+};
+
+template<template<typename> class Handler, typename P, typename Context>
+struct PluginEntries;
+
+template<template<typename> class Handler, typename... Ts, typename Context>
+struct PluginEntries<Handler, Pack<Ts...>, Context> {
+    constexpr static PluginTable::handler_t handlers[] = {
+        PluginEntry<Handler, Context, Ts>::value...
+    };
+
+    constexpr static PluginTable table = {
+        PluginTable::Version, std::uint32_t(sizeof...(Ts)),
+        LayoutHash_v<Pack<Ts...>>, LayoutHash_v<Pack<Context>>, handlers
+    };
+};
+
+inline void ignoreMessage(void *, const void *) {}
+
+}
+
+/// \brief The table of the <tt>Handler<T>::execute(Context &, const T &)</tt>
+/// for the types \c T of \c P, \c nullptr where \c Handler<T> declares none
+template<template<typename> class Handler, typename P, typename Context>
+constexpr const PluginTable &PluginTable_v =
+    detail::PluginEntries<Handler, P, Context>::table;
+
+/// \brief Name of the function, of C linkage, that returns the table of a
+/// shared object
+inline constexpr char PluginSymbol[] = "zoo_meta_plugin_table";
+
+/// \brief Dispatch of the types of \c P to handlers receiving a \c Context,
+/// the built in ones or those of plugins, through a table of function
+/// pointers that is replaced whole and atomically
+///
+/// \c execute loads the current table and jumps through the entry of the
+/// index, the same single indirect jump as an \c Instantiator; the entries of
+/// a plugin forward to its handlers, inlined in them.  \c install checks the
+/// hashes of the plugin and publishes a copy of the current table with the
+/// entries of the plugin; the tables replaced stay allocated, thus a thread
+/// in the middle of a dispatch is not disturbed
+/// \note the shared objects must stay loaded while their entries may run
+template<typename P, typename Context>
+class DispatchTable;
+
+template<typename... Ts, typename Context>
+class DispatchTable<Pack<Ts...>, Context> {
+    using handler_t = PluginTable::handler_t;
+    constexpr static std::size_t Size = sizeof...(Ts);
+
+    struct Entries {
+        handler_t handlers[Size];
+    };
+
+    std::mutex mutex_; ///< of the installers
+    std::vector<std::unique_ptr<Entries>> versions_;
+    std::atomic<const Entries *> current_;
+
+    static void check(const PluginTable &t) {
+        if(PluginTable::Version != t.version) {
+            throw std::runtime_error("Plugin table version mismatch");
+        }
+        if(Size != t.size || LayoutHash_v<Pack<Ts...>> != t.layoutHash) {
+            throw std::runtime_error("Plugin message layout mismatch");
+        }
+        if(LayoutHash_v<Pack<Context>> != t.contextHash) {
+            throw std::runtime_error("Plugin context layout mismatch");
+        }
+    }
+
+    void publish(std::unique_ptr<Entries> entries) {
+        current_.store(entries.get(), std::memory_order_release);
+        versions_.push_back(std::move(entries));
+    }
+
+public:
+    /// \param builtins the complete table, what it does not handle is ignored
+    explicit DispatchTable(const PluginTable &builtins) {
+        check(builtins);
+        auto entries = std::make_unique<Entries>();
+        for(std::size_t i = 0; i < Size; ++i) {
+            entries->handlers[i] = builtins.handlers[i] ?
+                builtins.handlers[i] : detail::ignoreMessage;
+        }
+        publish(std::move(entries));
+    }
+
+    DispatchTable(const DispatchTable &) = delete;
+    DispatchTable &operator=(const DispatchTable &) = delete;
+
+    void execute(Context &c, const void *message, std::size_t index) const {
+        current_.load(std::memory_order_acquire)->handlers[index](
+            static_cast<void *>(&c), message
+        );
+    }
+
+    /// \brief Replaces the entries that \c plugin handles
+    /// \throw std::runtime_error if the plugin was built for another version,
+    /// message space or context
+    void install(const PluginTable &plugin) {
+        check(plugin);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto entries = std::make_unique<Entries>(*versions_.back());
+        for(std::size_t i = 0; i < Size; ++i) {
+            if(plugin.handlers[i]) {
+                entries->handlers[i] = plugin.handlers[i];
+            }
+        }
+        publish(std::move(entries));
+    }
+
+    /// \brief Back to the built in handlers
+    void restore() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        publish(std::make_unique<Entries>(*versions_.front()));
+    }
+};
+
+/// \brief A shared object loaded with \c dlopen, exporting a \c PluginTable
+/// through \c ZOO_META_EXPORT_PLUGIN
+class Plugin {
+    void *handle_;
+    const PluginTable *table_;
+
+    static std::runtime_error error(const std::string &path) {
+        auto message = dlerror();
+        return std::runtime_error(path + ": " + (message ? message : "?"));
+    }
+
+public:
+    explicit Plugin(const std::string &path):
+        handle_(dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL))
+    {
+        if(!handle_) { throw error(path); }
+        auto symbol = dlsym(handle_, PluginSymbol);
+        if(!symbol) {
+            auto e = error(path);
+            dlclose(handle_);
+            throw e;
+        }
+        table_ = reinterpret_cast<const PluginTable *(*)()>(symbol)();
+    }
+
+    Plugin(Plugin &&other) noexcept:
+        handle_(std::exchange(other.handle_, nullptr)), table_(other.table_)
+    {}
+
+    Plugin(const Plugin &) = delete;
+    Plugin &operator=(const Plugin &) = delete;
+    Plugin &operator=(Plugin &&) = delete;
+
+    ~Plugin() {
+        if(handle_) { dlclose(handle_); }
+    }
+
+    const PluginTable &table() const noexcept { return *table_; }
+};
+
+}
+
+/// \brief Exports from a shared object the table of \c Handler for the types
+/// of \c P with \c Context, arguments that name types without commas
+#define ZOO_META_EXPORT_PLUGIN(Handler, P, Context) \
+    extern "C" const meta::PluginTable *zoo_meta_plugin_table() { \
+        return &meta::PluginTable_v<Handler, P, Context>; \
+    }
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef ZOO_META_SEQLOCK
+#define ZOO_META_SEQLOCK
+
+#include <meta/CacheLine.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#endif
+
+namespace meta {
+
+/// \brief Single writer, multiple readers publication of a trivially copyable
+/// \c T: the writer never waits, readers retry while a store overlaps
+///
+/// The value is kept in relaxed atomic words, thus the concurrent copies are
+/// not data races; the fences order them against the sequence counter
+template<typename T>
+class alignas(CacheLineSize) Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "");
+
+    using Word = std::uint64_t;
+    constexpr static auto Words = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    std::atomic<std::uint64_t> sequence_{0};
+    std::atomic<Word> words_[Words] = {};
+
+public:
+    Seqlock() = default;
+    explicit Seqlock(const T &initial) { store(initial); }
+
+    Seqlock(const Seqlock &) = delete;
+    Seqlock &operator=(const Seqlock &) = delete;
+
+    /// \note only one thread may store
+    void store(const T &value) noexcept {
+        Word buffer[Words] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        auto s = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for(std::size_t i = 0; i < Words; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        sequence_.store(s + 2, std::memory_order_release);
+    }
+
+    /// \brief single attempt, fails if a store overlapped
+    bool tryLoad(T &destination) const noexcept {
+        auto before = sequence_.load(std::memory_order_acquire);
+        if(before & 1) { return false; }
+        Word buffer[Words];
+        for(std::size_t i = 0; i < Words; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(before != sequence_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        std::memcpy(&destination, buffer, sizeof(T));
+        return true;
+    }
+
+    T load() const noexcept {
+        T rv;
+        while(!tryLoad(rv)) {}
+        return rv;
+    }
+
+    /// \brief number of completed stores
+    std::uint64_t version() const noexcept {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef ZOO_META_SHARDED_INSTANTIATOR
+#define ZOO_META_SHARDED_INSTANTIATOR
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <utility>
+#include <array>
+#endif
+
+namespace meta {
+
+/// \brief Like \c Instantiator, except that the handlers are instantiated in
+/// other translation units, in shards of <tt>2^ShardBits</tt> indices, to
+/// compile huge tables in parallel
+///
+/// The table holds the addresses of \c Entry<Shard, Offset>::execute, which
+/// are only declared here.  Each shard translation unit includes
+/// \c meta/ShardedInstantiatorShard.h and uses
+/// \c ZOO_META_INSTANTIATE_SHARD to explicitly instantiate its entries; their
+/// definitions forward to \c UserTemplate<Index>::execute, which gets inlined
+/// there, thus the dispatch is still a single indirect jump.
+/// \note the table extends to the end of the last shard, whose padding
+/// entries trap, thus the indices past \c Size in it fail loudly
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    unsigned ShardBits,
+    typename FunctionSignature
+>
+struct ShardedInstantiator;
+
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    unsigned ShardBits,
+    typename Return,
+    typename... Args
+>
+struct ShardedInstantiator<UserTemplate, Size, ShardBits, Return(Args...)> {
+    using return_t = Return;
+    using signature_t = return_t (*)(Args...);
+
+    constexpr static std::size_t shardSize = std::size_t(1) << ShardBits;
+    constexpr static std::size_t shards = (Size + shardSize - 1) / shardSize;
+
+    template<std::size_t Shard, std::size_t Offset>
+    struct Entry {
+        static return_t execute(Args... arguments);
+    };
+
+    static return_t execute(Args... arguments, std::size_t index) {
+        constexpr static auto jumpTable =
+            makeJumpTable(std::make_index_sequence<shards * shardSize>());
+        return jumpTable[index](std::forward<Args>(arguments)...);
+    }
+
+private:
+    template<std::size_t... Indices>
+    constexpr static std::array<signature_t, shards * shardSize>
+    makeJumpTable(std::index_sequence<Indices...>) {
+        return {{
+            Entry<(Indices >> ShardBits), (Indices & (shardSize - 1))>::
+                execute...
+        }};
+    }
+};
+
+}
+
+#endif
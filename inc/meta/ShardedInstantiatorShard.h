@@ -0,0 +1,83 @@
+#ifndef ZOO_META_SHARDED_INSTANTIATOR_SHARD
+#define ZOO_META_SHARDED_INSTANTIATOR_SHARD
+
+/// \file ShardedInstantiatorShard.h
+/// To be included only by the translation units that instantiate the shards
+/// of a \c ShardedInstantiator, the \c UserTemplate definitions must be
+/// visible
+
+#include <meta/ShardedInstantiator.h>
+
+namespace meta {
+
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    unsigned ShardBits,
+    typename Return,
+    typename... Args
+>
+template<std::size_t Shard, std::size_t Offset>
+Return
+ShardedInstantiator<UserTemplate, Size, ShardBits, Return(Args...)>::
+Entry<Shard, Offset>::execute(Args... arguments) {
+    constexpr auto index = (Shard << ShardBits) + Offset;
+    static_assert(Shard < shards, "Shard out of range");
+    if constexpr(index < Size) {
+        return UserTemplate<index>::execute(std::forward<Args>(arguments)...);
+    } else {
+        // padding at the end of the last shard, an index out of range
+        __builtin_trap();
+    }
+}
+
+}
+
+#define ZOO_META_REPEAT_0(M, D, S, O) M(D, S, O)
+#define ZOO_META_REPEAT_1(M, D, S, O) \
+    ZOO_META_REPEAT_0(M, D, S, O) ZOO_META_REPEAT_0(M, D, S, O + 1)
+#define ZOO_META_REPEAT_2(M, D, S, O) \
+    ZOO_META_REPEAT_1(M, D, S, O) ZOO_META_REPEAT_1(M, D, S, O + 2)
+#define ZOO_META_REPEAT_3(M, D, S, O) \
+    ZOO_META_REPEAT_2(M, D, S, O) ZOO_META_REPEAT_2(M, D, S, O + 4)
+#define ZOO_META_REPEAT_4(M, D, S, O) \
+    ZOO_META_REPEAT_3(M, D, S, O) ZOO_META_REPEAT_3(M, D, S, O + 8)
+#define ZOO_META_REPEAT_5(M, D, S, O) \
+    ZOO_META_REPEAT_4(M, D, S, O) ZOO_META_REPEAT_4(M, D, S, O + 16)
+#define ZOO_META_REPEAT_6(M, D, S, O) \
+    ZOO_META_REPEAT_5(M, D, S, O) ZOO_META_REPEAT_5(M, D, S, O + 32)
+#define ZOO_META_REPEAT_7(M, D, S, O) \
+    ZOO_META_REPEAT_6(M, D, S, O) ZOO_META_REPEAT_6(M, D, S, O + 64)
+#define ZOO_META_REPEAT_8(M, D, S, O) \
+    ZOO_META_REPEAT_7(M, D, S, O) ZOO_META_REPEAT_7(M, D, S, O + 128)
+#define ZOO_META_REPEAT_9(M, D, S, O) \
+    ZOO_META_REPEAT_8(M, D, S, O) ZOO_META_REPEAT_8(M, D, S, O + 256)
+#define ZOO_META_REPEAT_10(M, D, S, O) \
+    ZOO_META_REPEAT_9(M, D, S, O) ZOO_META_REPEAT_9(M, D, S, O + 512)
+#define ZOO_META_REPEAT_11(M, D, S, O) \
+    ZOO_META_REPEAT_10(M, D, S, O) ZOO_META_REPEAT_10(M, D, S, O + 1024)
+#define ZOO_META_REPEAT_12(M, D, S, O) \
+    ZOO_META_REPEAT_11(M, D, S, O) ZOO_META_REPEAT_11(M, D, S, O + 2048)
+
+#define ZOO_META_SHARD_ENTRY_DEFINITION(Dispatcher, Shard, Offset) \
+    template struct Dispatcher::Entry<(Shard), (Offset)>;
+#define ZOO_META_SHARD_ENTRY_DECLARATION(Dispatcher, Shard, Offset) \
+    extern template struct Dispatcher::Entry<(Shard), (Offset)>;
+
+/// \brief Explicit instantiation of the shard \c Shard of \c Dispatcher, a
+/// \c ShardedInstantiator named without template arguments (a type alias);
+/// \c ShardBits must be the literal of the \c ShardBits of the dispatcher
+#define ZOO_META_INSTANTIATE_SHARD(Dispatcher, ShardBits, Shard) \
+    static_assert(Dispatcher::shardSize == (1ul << ShardBits), ""); \
+    ZOO_META_REPEAT_##ShardBits( \
+        ZOO_META_SHARD_ENTRY_DEFINITION, Dispatcher, Shard, 0 \
+    )
+
+/// \brief For translation units that see the \c UserTemplate definitions and
+/// must not instantiate the entries of the shard \c Shard themselves
+#define ZOO_META_EXTERN_SHARD(Dispatcher, ShardBits, Shard) \
+    ZOO_META_REPEAT_##ShardBits( \
+        ZOO_META_SHARD_ENTRY_DECLARATION, Dispatcher, Shard, 0 \
+    )
+
+#endif
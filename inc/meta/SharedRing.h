@@ -0,0 +1,134 @@
+#ifndef ZOO_META_SHARED_RING
+#define ZOO_META_SHARED_RING
+
+#include <meta/LayoutHash.h>
+#include <meta/SpscRing.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace meta {
+
+/// \brief \c SpscRing of the types of \c P in POSIX shared memory, for a
+/// producer and a consumer in different processes of the same host
+///
+/// The creator names the segment; who attaches checks the version of the
+/// \c RingControl and that the \c LayoutHash of its \c P is the one of the
+/// creator, thus both agree on the indices and layouts of the messages.  The
+/// consumer dispatches the records in place in the mapping and sleeps on the
+/// futex word in it
+template<typename P>
+class SharedRing {
+    std::string name_;
+    void *memory_ = nullptr;
+    std::size_t size_ = 0;
+    bool owner_ = false;
+
+    SharedRing(std::string name, bool owner):
+        name_(std::move(name)), owner_(owner)
+    {}
+
+    void map(int fd) {
+        memory_ =
+            mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        auto error = errno;
+        close(fd);
+        if(MAP_FAILED == memory_) {
+            memory_ = nullptr;
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+    }
+
+public:
+    constexpr static auto layoutHash = LayoutHash_v<P>;
+
+    /// \param capacity in bytes, a power of two
+    /// \throw std::invalid_argument if it is not, before creating the segment
+    static SharedRing create(const std::string &name, std::size_t capacity) {
+        RingControl::checkCapacity(capacity);
+        SharedRing rv(name, true);
+        auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), name);
+        }
+        rv.size_ = RingControl::footprint(capacity);
+        if(ftruncate(fd, off_t(rv.size_))) {
+            auto error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), name);
+        }
+        rv.map(fd);
+        RingControl::create(rv.memory_, capacity, layoutHash);
+        return rv;
+    }
+
+    static SharedRing attach(const std::string &name) {
+        SharedRing rv(name, false);
+        auto fd = shm_open(name.c_str(), O_RDWR, 0);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), name);
+        }
+        struct stat status;
+        if(
+            fstat(fd, &status) ||
+            std::size_t(status.st_size) < sizeof(RingControl)
+        ) {
+            close(fd);
+            throw std::runtime_error(name + ": not a ring");
+        }
+        rv.size_ = std::size_t(status.st_size);
+        rv.map(fd);
+        auto &c = rv.control();
+        if(!c.ready.load(std::memory_order_acquire)) {
+            throw std::runtime_error(name + ": not initialized");
+        }
+        if(RingControl::Version != c.version) {
+            throw std::runtime_error(name + ": ring version mismatch");
+        }
+        if(layoutHash != c.layoutHash) {
+            throw std::runtime_error(name + ": message layout mismatch");
+        }
+        if(!RingControl::validCapacity(c.capacity)) {
+            throw std::runtime_error(name + ": capacity not a power of two");
+        }
+        if(RingControl::footprint(c.capacity) != rv.size_) {
+            throw std::runtime_error(name + ": size mismatch");
+        }
+        return rv;
+    }
+
+    SharedRing(SharedRing &&other) noexcept:
+        name_(std::move(other.name_)),
+        memory_(std::exchange(other.memory_, nullptr)),
+        size_(other.size_),
+        owner_(std::exchange(other.owner_, false))
+    {}
+
+    SharedRing &operator=(SharedRing &&) = delete;
+
+    ~SharedRing() {
+        if(memory_) { munmap(memory_, size_); }
+        if(owner_) { shm_unlink(name_.c_str()); }
+    }
+
+    RingControl &control() noexcept {
+        return *static_cast<RingControl *>(memory_);
+    }
+
+    RingProducer<P> producer() { return RingProducer<P>(control()); }
+    RingConsumer<P> consumer() { return RingConsumer<P>(control()); }
+};
+
+}
+
+#endif
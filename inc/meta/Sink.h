@@ -0,0 +1,23 @@
+#ifndef ZOO_META_SINK
+#define ZOO_META_SINK
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <cstddef>
+#include <type_traits>
+#endif
+
+namespace meta {
+
+/// \brief How the runtime components deliver messages: to a sink callable
+/// as \c Sink_t with the message and its index in the pack of the component,
+/// the arguments of an \c Instantiator dispatch over that pack
+/// \note the message is in storage of the component, the sink must not keep
+/// the pointer after the call
+using Sink_t = void(const void *message, std::size_t index);
+
+template<typename S>
+constexpr bool IsSink_v = std::is_invocable_v<S &, const void *, std::size_t>;
+
+}
+
+#endif
@@ -0,0 +1,279 @@
+#ifndef ZOO_META_SPSC_RING
+#define ZOO_META_SPSC_RING
+
+#include <meta/CacheLine.h>
+#include <meta/IndexOf.h>
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace meta {
+
+/// \brief The shared state of a ring, without pointers, thus it may live in
+/// memory mapped by several processes; the bytes follow it
+struct alignas(CacheLineSize) RingControl {
+    /// \brief of this layout, checked by who attaches
+    constexpr static std::uint32_t Version = 1;
+
+    std::uint32_t version;
+    std::uint64_t layoutHash;
+    std::uint64_t capacity; ///< of the bytes, a power of two
+    std::atomic<std::uint32_t> ready; ///< set last by the creator
+
+    alignas(CacheLineSize) std::atomic<std::uint64_t> head; ///< bytes written
+    alignas(CacheLineSize) std::atomic<std::uint64_t> tail; ///< bytes read
+    /// \brief futex word, bumped by the producer to wake the consumer
+    alignas(CacheLineSize) std::atomic<std::uint32_t> signal;
+    std::atomic<std::uint32_t> sleeping;
+
+    unsigned char *bytes() noexcept {
+        return reinterpret_cast<unsigned char *>(this + 1);
+    }
+
+    static std::size_t footprint(std::size_t capacity) noexcept {
+        return sizeof(RingControl) + capacity;
+    }
+
+    /// \brief the positions are masked with <tt>capacity - 1</tt>
+    constexpr static bool validCapacity(std::uint64_t capacity) noexcept {
+        return capacity && !(capacity & (capacity - 1));
+    }
+
+    /// \throw std::invalid_argument unless \c validCapacity
+    static std::size_t checkCapacity(std::size_t capacity) {
+        if(!validCapacity(capacity)) {
+            throw std::invalid_argument("Ring capacity not a power of two");
+        }
+        return capacity;
+    }
+
+    /// \brief constructs in \c memory of at least \c footprint(capacity)
+    /// \throw std::invalid_argument unless \c validCapacity
+    static RingControl *
+    create(void *memory, std::size_t capacity, std::uint64_t layoutHash) {
+        checkCapacity(capacity);
+        auto rv = new(memory) RingControl;
+        rv->version = Version;
+        rv->layoutHash = layoutHash;
+        rv->capacity = capacity;
+        rv->head.store(0, std::memory_order_relaxed);
+        rv->tail.store(0, std::memory_order_relaxed);
+        rv->signal.store(0, std::memory_order_relaxed);
+        rv->sleeping.store(0, std::memory_order_relaxed);
+        rv->ready.store(1, std::memory_order_release);
+        return rv;
+    }
+};
+
+namespace detail {
+
+/// \brief the header of each record, the payload follows 8 byte aligned
+struct RingRecord {
+    std::uint32_t size; ///< of the whole record
+    std::uint32_t index; ///< in the \c Pack, \c Padding to skip to the start
+};
+
+inline constexpr std::uint32_t Padding = ~std::uint32_t(0);
+
+constexpr std::size_t recordSize(std::size_t payload) {
+    return sizeof(RingRecord) + (payload + 7) / 8 * 8;
+}
+
+inline void futexWait(std::atomic<std::uint32_t> &word, std::uint32_t value) {
+#ifdef __linux__
+    // not FUTEX_PRIVATE_FLAG: the word may be shared by processes
+    syscall(SYS_futex, &word, FUTEX_WAIT, value, nullptr, nullptr, 0);
+#else
+    while(value == word.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+inline void futexWake(std::atomic<std::uint32_t> &word) {
+#ifdef __linux__
+    syscall(SYS_futex, &word, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+}
+
+/// \brief Writes records of the types of \c P into a \c RingControl, one
+/// thread only
+///
+/// \c push only writes, \c commit makes the records written visible and
+/// wakes the consumer if it sleeps, thus a batch pays the synchronization
+/// once
+template<typename P>
+class RingProducer {
+    RingControl *control_;
+    unsigned char *bytes_;
+    std::uint64_t mask_, head_, tail_;
+
+public:
+    explicit RingProducer(RingControl &c):
+        control_(&c), bytes_(c.bytes()), mask_(c.capacity - 1),
+        head_(c.head.load(std::memory_order_relaxed)),
+        tail_(c.tail.load(std::memory_order_acquire))
+    {}
+
+    /// \return false if there is no space
+    template<typename Message>
+    bool push(const Message &m) noexcept {
+        static_assert(std::is_trivially_copyable<Message>::value, "");
+        static_assert(alignof(Message) <= 8, "Payloads are 8 byte aligned");
+        constexpr auto size = detail::recordSize(sizeof(Message));
+        auto position = head_ & mask_;
+        auto contiguous = mask_ + 1 - position;
+        auto needed = size <= contiguous ? size : contiguous + size;
+        if(mask_ + 1 < head_ + needed - tail_) {
+            tail_ = control_->tail.load(std::memory_order_acquire);
+            if(mask_ + 1 < head_ + needed - tail_) { return false; }
+        }
+        if(size > contiguous) {
+            detail::RingRecord padding{
+                std::uint32_t(contiguous), detail::Padding
+            };
+            std::memcpy(bytes_ + position, &padding, sizeof(padding));
+            head_ += contiguous;
+            position = 0;
+        }
+        detail::RingRecord header{
+            std::uint32_t(size), std::uint32_t(IndexOf_v<Message, P>)
+        };
+        std::memcpy(bytes_ + position, &header, sizeof(header));
+        std::memcpy(bytes_ + position + sizeof(header), &m, sizeof(m));
+        head_ += size;
+        return true;
+    }
+
+    /// \brief Makes the records written visible without waking the consumer,
+    /// for consumers that poll
+    void publish() noexcept {
+        control_->head.store(head_, std::memory_order_release);
+    }
+
+    void commit() noexcept {
+        control_->head.store(head_, std::memory_order_release);
+        // orders the store of head before the load of sleeping, against the
+        // opposite order in the consumer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(control_->sleeping.load(std::memory_order_relaxed)) {
+            control_->sleeping.store(0, std::memory_order_relaxed);
+            control_->signal.fetch_add(1, std::memory_order_release);
+            detail::futexWake(control_->signal);
+        }
+    }
+};
+
+/// \brief Dispatches the records of a \c RingControl in place, one thread
+/// only
+template<typename P>
+class RingConsumer {
+    RingControl *control_;
+    const unsigned char *bytes_;
+    std::uint64_t mask_, tail_;
+
+public:
+    explicit RingConsumer(RingControl &c):
+        control_(&c), bytes_(c.bytes()), mask_(c.capacity - 1),
+        tail_(c.tail.load(std::memory_order_relaxed))
+    {}
+
+    /// \brief Delivers up to \c limit records to a \c Sink_t, pointing into
+    /// the ring; their space is returned to the producer after the batch
+    template<typename Sink>
+    std::size_t poll(Sink &&sink, std::size_t limit = ~std::size_t(0)) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        auto head = control_->head.load(std::memory_order_acquire);
+        std::size_t delivered = 0;
+        while(tail_ != head && delivered < limit) {
+            auto at = bytes_ + (tail_ & mask_);
+            detail::RingRecord header;
+            std::memcpy(&header, at, sizeof(header));
+            if(detail::Padding != header.index) {
+                sink(
+                    static_cast<const void *>(at + sizeof(header)),
+                    std::size_t(header.index)
+                );
+                ++delivered;
+            }
+            tail_ += header.size;
+        }
+        control_->tail.store(tail_, std::memory_order_release);
+        return delivered;
+    }
+
+    /// \brief Returns when there may be records, spinning \c spins times
+    /// before sleeping on the futex
+    void wait(std::size_t spins = 1024) noexcept {
+        for(std::size_t i = 0; i < spins; ++i) {
+            if(tail_ != control_->head.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+        auto signal = control_->signal.load(std::memory_order_acquire);
+        control_->sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(tail_ != control_->head.load(std::memory_order_relaxed)) {
+            control_->sleeping.store(0, std::memory_order_relaxed);
+            return;
+        }
+        detail::futexWait(control_->signal, signal);
+    }
+};
+
+/// \brief In process single producer, single consumer ring of records of the
+/// types of \c P
+template<typename P>
+class SpscRing {
+    struct Free {
+        void operator()(RingControl *c) const noexcept {
+            c->~RingControl();
+            ::operator delete(c, std::align_val_t(CacheLineSize));
+        }
+    };
+
+    std::unique_ptr<RingControl, Free> control_;
+
+public:
+    /// \param capacity in bytes, a power of two
+    /// \throw std::invalid_argument if it is not
+    explicit SpscRing(std::size_t capacity):
+        control_(
+            RingControl::create(
+                ::operator new(
+                    RingControl::footprint(
+                        RingControl::checkCapacity(capacity)
+                    ),
+                    std::align_val_t(CacheLineSize)
+                ),
+                capacity, 0
+            )
+        )
+    {}
+
+    RingProducer<P> producer() { return RingProducer<P>(*control_); }
+    RingConsumer<P> consumer() { return RingConsumer<P>(*control_); }
+};
+
+}
+
+#endif
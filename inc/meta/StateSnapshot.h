@@ -0,0 +1,279 @@
+#ifndef ZOO_META_STATE_SNAPSHOT
+#define ZOO_META_STATE_SNAPSHOT
+
+#include <meta/CacheLine.h>
+#include <meta/IndexOf.h>
+#include <meta/LayoutHash.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace meta {
+
+/// \brief The start of a snapshot file, the sections follow
+struct SnapshotHeader {
+    constexpr static std::uint64_t Magic = 0x31504E41534F4F5Aull; // "ZOOSNAP1"
+    constexpr static std::uint32_t Version = 1;
+
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t sections;
+    std::uint64_t layoutHash;
+    std::uint64_t size; ///< of the whole file
+    std::uint64_t sequence; ///< of the last message applied to the state
+};
+
+/// \brief Where the array of a type is in the file
+struct SnapshotSection {
+    std::uint64_t offset, count;
+};
+
+/// \brief A file holding an array of each of the trivially copyable types of
+/// \c P, the state of the handlers of each type and their arenas, as of a
+/// sequence number of the message stream
+///
+/// \c create maps a temporary file sized for the counts of each type; the
+/// state is copied into the arrays and \c commit syncs it, renames it over
+/// the snapshot, unmaps it and syncs the directory, thus a crash leaves the
+/// previous snapshot and nothing writes to the committed one.  \c open maps
+/// the file privately, copy on write, after checking its version, size,
+/// alignment of the sections and the \c LayoutHash of \c P; the handlers
+/// work on the arrays in place, the pages come from the page cache when first
+/// touched, and only the messages after \c sequence need to be replayed
+template<typename P>
+class StateSnapshot;
+
+template<typename... Ts>
+class StateSnapshot<Pack<Ts...>> {
+    static_assert(
+        (std::is_trivially_copyable<Ts>::value && ...),
+        "The state is saved as bytes"
+    );
+    static_assert(0 < sizeof...(Ts), "A snapshot of nothing");
+
+    constexpr static std::size_t Sections = sizeof...(Ts);
+
+    std::string path_, temporary_;
+    void *memory_ = nullptr;
+    std::size_t size_ = 0;
+
+    StateSnapshot(std::string path, std::string temporary):
+        path_(std::move(path)), temporary_(std::move(temporary))
+    {}
+
+    void map(int fd, int flags) {
+        memory_ =
+            mmap(nullptr, size_, PROT_READ | PROT_WRITE, flags, fd, 0);
+        auto error = errno;
+        close(fd);
+        if(MAP_FAILED == memory_) {
+            memory_ = nullptr;
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+    }
+
+    SnapshotHeader &header() noexcept {
+        return *static_cast<SnapshotHeader *>(memory_);
+    }
+
+    const SnapshotHeader &header() const noexcept {
+        return *static_cast<const SnapshotHeader *>(memory_);
+    }
+
+    SnapshotSection *sections() const noexcept {
+        return reinterpret_cast<SnapshotSection *>(
+            static_cast<unsigned char *>(memory_) + sizeof(SnapshotHeader)
+        );
+    }
+
+    constexpr static std::size_t align(std::size_t at) {
+        return (at + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+    }
+
+public:
+    constexpr static auto layoutHash = LayoutHash_v<Pack<Ts...>>;
+    using Counts = std::array<std::size_t, Sections>;
+
+    /// \param counts of the elements of each type, in the order of the \c Pack
+    static StateSnapshot
+    create(const std::string &path, const Counts &counts) {
+        static_assert(
+            ((alignof(Ts) <= CacheLineSize) && ...),
+            "The arrays are cache line aligned"
+        );
+        StateSnapshot rv(path, path + ".tmp");
+        auto fd = ::open(
+            rv.temporary_.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0600
+        );
+        if(fd < 0) {
+            throw std::system_error(
+                errno, std::generic_category(), rv.temporary_
+            );
+        }
+        constexpr std::size_t sizes[] = { sizeof(Ts)... };
+        SnapshotSection placed[Sections];
+        auto at = align(
+            sizeof(SnapshotHeader) + Sections * sizeof(SnapshotSection)
+        );
+        for(std::size_t i = 0; i < Sections; ++i) {
+            placed[i] = { at, counts[i] };
+            at = align(at + sizes[i] * counts[i]);
+        }
+        rv.size_ = at;
+        if(ftruncate(fd, off_t(rv.size_))) {
+            auto error = errno;
+            close(fd);
+            throw std::system_error(
+                error, std::generic_category(), rv.temporary_
+            );
+        }
+        rv.map(fd, MAP_SHARED);
+        rv.header() = {
+            SnapshotHeader::Magic, SnapshotHeader::Version,
+            std::uint32_t(Sections), layoutHash, rv.size_, 0
+        };
+        for(std::size_t i = 0; i < Sections; ++i) {
+            rv.sections()[i] = placed[i];
+        }
+        return rv;
+    }
+
+    static StateSnapshot open(const std::string &path) {
+        StateSnapshot rv(path, std::string());
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+        struct stat status;
+        if(
+            fstat(fd, &status) ||
+            std::size_t(status.st_size) <
+                sizeof(SnapshotHeader) + Sections * sizeof(SnapshotSection)
+        ) {
+            close(fd);
+            throw std::runtime_error(path + ": not a snapshot");
+        }
+        rv.size_ = std::size_t(status.st_size);
+        rv.map(fd, MAP_PRIVATE);
+        auto &h = rv.header();
+        if(SnapshotHeader::Magic != h.magic) {
+            throw std::runtime_error(path + ": not a snapshot");
+        }
+        if(SnapshotHeader::Version != h.version) {
+            throw std::runtime_error(path + ": snapshot version mismatch");
+        }
+        if(layoutHash != h.layoutHash || Sections != h.sections) {
+            throw std::runtime_error(path + ": state layout mismatch");
+        }
+        constexpr std::size_t sizes[] = { sizeof(Ts)... };
+        constexpr std::size_t alignments[] = { alignof(Ts)... };
+        for(std::size_t i = 0; i < Sections; ++i) {
+            auto &s = rv.sections()[i];
+            if(
+                rv.size_ < s.offset ||
+                (rv.size_ - s.offset) / sizes[i] < s.count
+            ) {
+                throw std::runtime_error(path + ": size mismatch");
+            }
+            // the mapping is page aligned, the offset must be for the type
+            if(s.offset % alignments[i]) {
+                throw std::runtime_error(path + ": misaligned section");
+            }
+        }
+        if(rv.size_ != h.size) {
+            throw std::runtime_error(path + ": size mismatch");
+        }
+        return rv;
+    }
+
+    StateSnapshot(StateSnapshot &&other) noexcept:
+        path_(std::move(other.path_)),
+        temporary_(std::move(other.temporary_)),
+        memory_(std::exchange(other.memory_, nullptr)),
+        size_(other.size_)
+    {
+        other.temporary_.clear();
+    }
+
+    StateSnapshot &operator=(StateSnapshot &&) = delete;
+
+    /// \brief Discards a snapshot created and not committed
+    ~StateSnapshot() {
+        if(memory_) { munmap(memory_, size_); }
+        if(!temporary_.empty()) { unlink(temporary_.c_str()); }
+    }
+
+    /// \note neither the arrays nor \c count and \c sequence are available
+    /// after \c commit
+    template<typename T>
+    T *data() noexcept {
+        assert(memory_);
+        return reinterpret_cast<T *>(
+            static_cast<unsigned char *>(memory_) +
+                sections()[IndexOf_v<T, Ts...>].offset
+        );
+    }
+
+    template<typename T>
+    std::size_t count() const noexcept {
+        assert(memory_);
+        return std::size_t(sections()[IndexOf_v<T, Ts...>].count);
+    }
+
+    std::uint64_t sequence() const noexcept {
+        assert(memory_);
+        return header().sequence;
+    }
+
+    /// \brief Makes the state copied so far, as of \c sequence, the snapshot,
+    /// and unmaps it: a shared mapping written after the rename would change
+    /// the committed file
+    /// \note the directory is synced too, else the rename may not survive a
+    /// crash
+    /// \throw std::system_error if syncing or renaming fails
+    void commit(std::uint64_t sequence) {
+        assert(memory_ && !temporary_.empty());
+        header().sequence = sequence;
+        if(msync(memory_, size_, MS_SYNC)) {
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+        if(rename(temporary_.c_str(), path_.c_str())) {
+            throw std::system_error(errno, std::generic_category(), path_);
+        }
+        temporary_.clear();
+        munmap(std::exchange(memory_, nullptr), size_);
+        auto slash = path_.rfind('/');
+        auto directory =
+            std::string::npos == slash ? std::string(".") :
+            0 == slash ? std::string("/") : path_.substr(0, slash);
+        auto fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if(fd < 0) {
+            throw std::system_error(errno, std::generic_category(), directory);
+        }
+        auto synced = fsync(fd);
+        auto error = errno;
+        close(fd);
+        if(synced) {
+            throw std::system_error(error, std::generic_category(), directory);
+        }
+    }
+};
+
+}
+
+#endif
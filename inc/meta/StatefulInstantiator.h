@@ -0,0 +1,238 @@
+#ifndef ZOO_META_STATEFUL_INSTANTIATOR
+#define ZOO_META_STATEFUL_INSTANTIATOR
+
+#include <meta/CacheLine.h>
+#include <meta/Instantiator.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace meta {
+namespace detail {
+
+template<typename T, typename = void>
+struct DeclaredState {
+    using type = void;
+};
+
+template<typename T>
+struct DeclaredState<T, std::void_t<typename T::state_t>> {
+    using type = typename T::state_t;
+};
+
+template<typename T>
+constexpr std::size_t StateSize = sizeof(T);
+
+template<>
+constexpr std::size_t StateSize<void> = 0;
+
+template<typename T>
+constexpr std::size_t StateAlignment = alignof(T);
+
+template<>
+constexpr std::size_t StateAlignment<void> = 1;
+
+/// \brief Value initialized by zeroing, never destroyed
+template<typename T>
+constexpr bool TrivialState =
+    std::is_trivially_default_constructible<T>::value &&
+    std::is_trivially_destructible<T>::value;
+
+template<>
+constexpr bool TrivialState<void> = true;
+
+/// \brief Offsets of the states of the <tt>UserTemplate<I></tt>, packed in
+/// index order, each at its alignment
+template<template<std::size_t> class UserTemplate, typename Indices>
+struct StateLayout;
+
+template<template<std::size_t> class UserTemplate, std::size_t... Indices>
+struct StateLayout<UserTemplate, std::index_sequence<Indices...>> {
+    static_assert(0 < sizeof...(Indices), "No index to dispatch to");
+
+    constexpr static std::size_t
+        sizes[] = {
+            StateSize<typename DeclaredState<UserTemplate<Indices>>::type>...
+        },
+        alignments[] = {
+            StateAlignment<
+                typename DeclaredState<UserTemplate<Indices>>::type
+            >...
+        };
+
+    constexpr static auto offsets = [] {
+        std::array<std::size_t, sizeof...(Indices)> rv = {};
+        std::size_t at = 0;
+        for(std::size_t i = 0; i < sizeof...(Indices); ++i) {
+            at = (at + alignments[i] - 1) / alignments[i] * alignments[i];
+            rv[i] = at;
+            at += sizes[i];
+        }
+        return rv;
+    }();
+
+    constexpr static std::size_t
+        size = offsets[sizeof...(Indices) - 1] + sizes[sizeof...(Indices) - 1],
+        alignment = [] {
+            auto rv = CacheLineSize;
+            for(auto a: alignments) { if(rv < a) { rv = a; } }
+            return rv;
+        }();
+
+    constexpr static bool trivial =
+        (TrivialState<typename DeclaredState<UserTemplate<Indices>>::type> &&
+            ...);
+};
+
+}
+
+/// \brief \c Instantiator in which each <tt>UserTemplate<I></tt> may declare
+/// a \c state_t, then its \c execute receives a reference to its state as the
+/// first argument
+///
+/// The states of all the indices are laid out in one cache-line aligned
+/// \c States block, by default one per thread.  The offset of each state is a
+/// constant within its table entry, so finding the state costs an addition.
+/// The states are value initialized, they must be nothrow default
+/// constructible.
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    typename FunctionSignature
+>
+struct StatefulInstantiator;
+
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    typename Return,
+    typename... Args
+>
+struct StatefulInstantiator<UserTemplate, Size, Return(Args...)> {
+    template<std::size_t Index>
+    using state_t = typename detail::DeclaredState<UserTemplate<Index>>::type;
+
+    using Layout =
+        detail::StateLayout<UserTemplate, std::make_index_sequence<Size>>;
+
+private:
+    template<std::size_t Index>
+    static state_t<Index> &state(unsigned char *bytes) noexcept {
+        return *std::launder(
+            reinterpret_cast<state_t<Index> *>(bytes + Layout::offsets[Index])
+        );
+    }
+
+    /// \brief The bytes of the states, zero, which value initializes states
+    /// that are trivial
+    class Bytes {
+    protected:
+        alignas(Layout::alignment)
+            unsigned char bytes_[Layout::size ? Layout::size : 1];
+
+        constexpr Bytes() noexcept: bytes_{} {}
+    };
+
+    /// \brief Constructs and destroys the states that are not trivial
+    class Constructed: protected Bytes {
+        template<std::size_t Index>
+        void construct() noexcept {
+            if constexpr(!std::is_void<state_t<Index>>::value) {
+                static_assert(
+                    std::is_nothrow_default_constructible<
+                        state_t<Index>
+                    >::value,
+                    "States must be nothrow default constructible"
+                );
+                new(this->bytes_ + Layout::offsets[Index]) state_t<Index>();
+            }
+        }
+
+        template<std::size_t Index>
+        void destroy() noexcept {
+            if constexpr(!std::is_void<state_t<Index>>::value) {
+                state<Index>(this->bytes_).~state_t<Index>();
+            }
+        }
+
+        template<std::size_t... Indices>
+        void constructAll(std::index_sequence<Indices...>) noexcept {
+            (construct<Indices>(), ...);
+        }
+
+        template<std::size_t... Indices>
+        void destroyAll(std::index_sequence<Indices...>) noexcept {
+            (destroy<Indices>(), ...);
+        }
+
+    protected:
+        Constructed() noexcept {
+            constructAll(std::make_index_sequence<Size>());
+        }
+        ~Constructed() { destroyAll(std::make_index_sequence<Size>()); }
+    };
+
+public:
+    /// \brief Trivial to destroy and \c constexpr to construct when all the
+    /// states are trivial, then a \c thread_local block needs no guard
+    class States:
+        std::conditional_t<Layout::trivial, Bytes, Constructed>
+    {
+    public:
+        States() noexcept = default;
+
+        States(const States &) = delete;
+        States &operator=(const States &) = delete;
+
+        template<std::size_t Index>
+        state_t<Index> &get() noexcept { return state<Index>(this->bytes_); }
+    };
+
+    /// \brief The states of the current thread
+    /// \note with states that are not trivial, each call checks whether the
+    /// block of the thread is constructed; a loop calls this once and then
+    /// \c executeWith
+    static States &threadStates() noexcept {
+        thread_local States rv;
+        return rv;
+    }
+
+    static Return execute(Args... arguments, std::size_t index) {
+        return executeWith(
+            threadStates(), std::forward<Args>(arguments)..., index
+        );
+    }
+
+    static Return
+    executeWith(States &states, Args... arguments, std::size_t index) {
+        return Instantiator<Entry, Size, Return(States &, Args...)>::execute(
+            states, std::forward<Args>(arguments)..., index
+        );
+    }
+
+private:
+    template<std::size_t Index>
+    struct Entry {
+        static Return execute(States &states, Args... arguments) {
+            if constexpr(std::is_void<state_t<Index>>::value) {
+                return UserTemplate<Index>::execute(
+                    std::forward<Args>(arguments)...
+                );
+            } else {
+                return UserTemplate<Index>::execute(
+                    states.template get<Index>(),
+                    std::forward<Args>(arguments)...
+                );
+            }
+        }
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,218 @@
+#ifndef ZOO_META_SUPERSEDING_SHEDDER
+#define ZOO_META_SUPERSEDING_SHEDDER
+
+#include <meta/LoadShedder.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace meta {
+
+/// \brief How a message shed by a \c SupersedingShedder supersedes the
+/// pending messages of its group
+enum class Supersession: std::uint8_t {
+    None, ///< not conflated, dropped if shed
+    /// \brief it supersedes the pending message of its type and value, the
+    /// ones of other values commute with it
+    Commuting,
+    /// \brief the pending message of its type at another value is delivered
+    /// ahead of it
+    Ordered
+};
+
+namespace detail {
+
+template<template<typename> class Superseding>
+struct SupersessionConflated {
+    template<typename T>
+    using type =
+        std::bool_constant<Supersession::None != Superseding<T>::value>;
+};
+
+template<typename P, template<typename> class Superseding>
+struct SupersessionTable;
+
+template<typename... Ts, template<typename> class Superseding>
+struct SupersessionTable<Pack<Ts...>, Superseding> {
+    constexpr static std::size_t Size = sizeof...(Ts);
+    constexpr static Supersession kinds[] = { Superseding<Ts>::value... };
+
+    constexpr static std::size_t count(Supersession kind) {
+        std::size_t rv = 0;
+        for(auto k: kinds) { rv += kind == k; }
+        return rv;
+    }
+
+    constexpr static auto make() {
+        std::array<std::size_t, Size> rv = {};
+        std::size_t next[3] = {};
+        for(std::size_t i = 0; i < Size; ++i) {
+            rv[i] = next[std::size_t(kinds[i])]++;
+        }
+        return rv;
+    }
+
+    constexpr static std::size_t
+        Commuting = count(Supersession::Commuting),
+        Ordered = count(Supersession::Ordered);
+    /// \brief by index in the pack, the position among the types of its kind
+    constexpr static auto slots = make();
+};
+
+}
+
+/// \brief \c LoadShedder that keeps the state of the consumer: a message shed
+/// is conflated only into the pending message it supersedes, and the pending
+/// messages are delivered ahead of a message that must not overtake them
+///
+/// Each message belongs to a group, such as an instrument, and has a value,
+/// such as a price, given with it to \c offer.  A type \c T is conflated if
+/// <tt>Superseding<T>::value</tt> is not \c Supersession::None.  The pending
+/// messages of a group are either all \c Commuting or all \c Ordered, a
+/// message of the other kind delivers them first.  A \c Commuting message
+/// supersedes the pending one of its type, group and value; an \c Ordered
+/// message supersedes the pending one of its type and group if it has the
+/// same value, else that one is delivered first
+/// \note the values of a group congruent modulo \c Window share a key of the
+/// underlying \c LoadShedder, the value pending of each type is kept to tell
+/// them apart; a value kept of a message delivered since only costs flushing
+/// nothing
+template<
+    typename P, template<typename> class Priority,
+    template<typename> class Superseding, std::size_t Window = 16
+>
+class SupersedingShedder {
+    static_assert(0 < Window && Window < 32, "The keys of a group are bits");
+
+    using Shedder = LoadShedder<
+        P, Priority,
+        detail::SupersessionConflated<Superseding>::template type
+    >;
+    using Table = detail::SupersessionTable<P, Superseding>;
+
+    constexpr static auto None = std::numeric_limits<std::int64_t>::min();
+    /// \brief in \c pending_, the group has \c Ordered messages
+    constexpr static std::uint32_t Ordered = std::uint32_t(1) << Window;
+
+    Shedder shedder_;
+    /// \brief by group, the mask of the keys of its pending \c Commuting
+    /// messages, by value modulo \c Window, or \c Ordered
+    std::vector<std::uint32_t> pending_;
+    /// \brief of the \c Commuting message pending by key and type, or \c None
+    std::vector<std::int64_t> commuting_;
+    /// \brief of the \c Ordered message pending by group and type, or \c None
+    std::vector<std::int64_t> ordered_;
+
+    static std::size_t key(std::uint32_t group, std::int64_t value) {
+        return group * Window + std::size_t(value) % Window;
+    }
+
+    /// \brief after a drain, the values kept may stay
+    void forget() { std::fill(pending_.begin(), pending_.end(), 0); }
+
+public:
+    using Thresholds = typename Shedder::Thresholds;
+
+    /// \param groups the bound of the groups
+    SupersedingShedder(const Thresholds &thresholds, std::uint32_t groups):
+        shedder_(thresholds, groups * Window),
+        pending_(groups, 0),
+        commuting_(groups * Window * Table::Commuting, None),
+        ordered_(groups * Table::Ordered, None)
+    {}
+
+    /// \brief of the type of index \c index in \c P
+    constexpr static Supersession supersession(std::size_t index) {
+        return Table::kinds[index];
+    }
+
+    /// \brief Sets the level for the backlog, delivering the conflated
+    /// messages if it goes down
+    template<typename Sink>
+    void backlog(std::size_t size, Sink &&sink) {
+        auto level = shedder_.level();
+        shedder_.backlog(size, sink);
+        if(shedder_.level() < level) { forget(); }
+    }
+
+    /// \param index of the message in \c P
+    template<typename Sink>
+    Admission offer(
+        std::uint32_t group, std::int64_t value, const void *message,
+        std::size_t index, Sink &&sink
+    ) {
+        assert(index < Table::Size && group < pending_.size());
+        auto kind = Table::kinds[index];
+        auto k = key(group, value);
+        if(Supersession::None == kind) {
+            return shedder_.offer(k, message, index, sink);
+        }
+        auto ordered = Supersession::Ordered == kind;
+        auto mask = pending_[group];
+        if(ordered ? mask & ~Ordered : mask & Ordered) { flush(group, sink); }
+        auto slot = Table::slots[index];
+        auto &pending = ordered ?
+            ordered_[group * Table::Ordered + slot] :
+            commuting_[k * Table::Commuting + slot];
+        if(None != pending && value != pending) {
+            shedder_.flush(ordered ? key(group, pending) : k, sink);
+            pending = None;
+        }
+        auto rv = shedder_.offer(k, message, index, sink);
+        if(Admission::Conflate == rv) {
+            pending = value;
+            pending_[group] |=
+                ordered ? Ordered : std::uint32_t(1) << k % Window;
+        }
+        return rv;
+    }
+
+    /// \brief Delivers the messages \c group has pending
+    template<typename Sink>
+    void flush(std::uint32_t group, Sink &&sink) {
+        auto mask = pending_[group];
+        pending_[group] = 0;
+        if(Ordered & mask) {
+            auto values = &ordered_[group * Table::Ordered];
+            for(std::size_t t = 0; t < Table::Ordered; ++t) {
+                if(None == values[t]) { continue; }
+                shedder_.flush(key(group, values[t]), sink);
+                values[t] = None;
+            }
+            return;
+        }
+        while(mask) {
+            auto k = group * Window + std::size_t(__builtin_ctz(mask));
+            mask &= mask - 1;
+            shedder_.flush(k, sink);
+            std::fill_n(
+                &commuting_[k * Table::Commuting], Table::Commuting, None
+            );
+        }
+    }
+
+    /// \brief Delivers the conflated messages pending
+    template<typename Sink>
+    void drain(Sink &&sink) {
+        shedder_.drain(sink);
+        forget();
+    }
+
+    std::size_t level() const noexcept { return shedder_.level(); }
+
+    std::uint64_t count(Admission a) const noexcept {
+        return shedder_.count(a);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef ZOO_META_TABLE
+#define ZOO_META_TABLE
+
+#include <meta/CacheLine.h>
+#include <meta/Instantiator.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace meta {
+
+namespace detail {
+
+template<template<std::size_t> class Generator, std::size_t... Indices>
+constexpr auto makeTable(std::index_sequence<Indices...>) {
+    using value_type = std::remove_cv_t<decltype(Generator<0>::value)>;
+    return std::array<value_type, sizeof...(Indices)>{{
+        Generator<Indices>::value...
+    }};
+}
+
+template<auto Function, std::size_t... Indices>
+constexpr auto makeFunctionTable(std::index_sequence<Indices...>) {
+    using value_type = std::remove_cv_t<decltype(Function(std::size_t(0)))>;
+    return std::array<value_type, sizeof...(Indices)>{{
+        Function(Indices)...
+    }};
+}
+
+}
+
+/// \brief Read-only array of <tt>Generator<I>::value</tt> for each index,
+/// the data analogous of \c Instantiator: instead of jumping into
+/// <tt>UserTemplate<I>::execute</tt>, \c execute loads the element
+template<template<std::size_t> class Generator, std::size_t Size>
+struct Table {
+    alignas(CacheLineSize) constexpr static auto values =
+        detail::makeTable<Generator>(std::make_index_sequence<Size>());
+
+    using value_type = typename decltype(values)::value_type;
+
+    static value_type execute(std::size_t index) { return values[index]; }
+};
+
+/// \brief No element, nor <tt>Generator<0></tt> to tell their type
+template<template<std::size_t> class Generator>
+struct Table<Generator, 0> {
+    constexpr static std::array<std::nullptr_t, 0> values = {};
+
+    using value_type = std::nullptr_t;
+};
+
+/// \brief Read-only array of <tt>Function(I)</tt> for each index, \c Function
+/// being \c constexpr
+template<auto Function, std::size_t Size>
+struct FunctionTable {
+    alignas(CacheLineSize) constexpr static auto values =
+        detail::makeFunctionTable<Function>(std::make_index_sequence<Size>());
+
+    using value_type = typename decltype(values)::value_type;
+
+    static value_type execute(std::size_t index) { return values[index]; }
+};
+
+namespace detail {
+
+template<typename T, typename = void>
+struct HasExecute: std::false_type {};
+
+template<typename T>
+struct HasExecute<T, std::void_t<decltype(&T::execute)>>: std::true_type {};
+
+/// \brief The type of the elements of a \c Table of \c UserTemplate
+template<template<std::size_t> class UserTemplate>
+using TableElement_t = std::remove_cv_t<decltype(UserTemplate<0>::value)>;
+
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Index,
+    typename = void
+>
+struct IsConstant: std::false_type {};
+
+template<typename T>
+constexpr bool constantCopy(T) { return true; }
+
+// the copy into the element type reads \c value, thus it is only a constant
+// expression if \c value is, and the braces reject narrowing; a handler
+// with an \c execute is called even if it has a \c value too
+template<template<std::size_t> class UserTemplate, std::size_t Index>
+struct IsConstant<
+    UserTemplate,
+    Index,
+    std::enable_if_t<
+        constantCopy<TableElement_t<UserTemplate>>({
+            UserTemplate<Index>::value
+        })
+    >
+>: std::integral_constant<bool, !HasExecute<UserTemplate<Index>>::value> {};
+
+template<template<std::size_t> class UserTemplate, typename Indices>
+struct AllConstant;
+
+template<template<std::size_t> class UserTemplate, std::size_t... Indices>
+struct AllConstant<UserTemplate, std::index_sequence<Indices...>>:
+    std::integral_constant<
+        bool, (IsConstant<UserTemplate, Indices>::value && ...)
+    >
+{};
+
+}
+
+/// \brief Whether every <tt>UserTemplate<I></tt> has a \c value that is a
+/// constant expression of the type of the one of index 0, and no \c execute
+template<template<std::size_t> class UserTemplate, std::size_t Size>
+constexpr bool AllConstant_v =
+    detail::AllConstant<UserTemplate, std::make_index_sequence<Size>>::value;
+
+/// \brief \c Instantiator that becomes a load from a \c Table when every
+/// <tt>UserTemplate<I></tt> is a constant; the arguments are then ignored
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    typename FunctionSignature
+>
+struct TableInstantiator;
+
+template<
+    template<std::size_t> class UserTemplate,
+    std::size_t Size,
+    typename Return,
+    typename... Args
+>
+struct TableInstantiator<UserTemplate, Size, Return(Args...)> {
+    /// \brief never with no index, there is no element type then
+    constexpr static bool isTable =
+        0 < Size && AllConstant_v<UserTemplate, Size>;
+
+    static Return execute(Args... arguments, std::size_t index) {
+        if constexpr(isTable) {
+            return Table<UserTemplate, Size>::values[index];
+        } else {
+            return Instantiator<UserTemplate, Size, Return(Args...)>::execute(
+                std::forward<Args>(arguments)..., index
+            );
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef ZOO_META_TIMER_WHEEL
+#define ZOO_META_TIMER_WHEEL
+
+#include <meta/IndexOf.h>
+#include <meta/PayloadLayout.h>
+#include <meta/Sink.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#endif
+
+namespace meta {
+
+/// \brief Identifies a scheduled timer, it stays safe to cancel after the
+/// timer fired or was cancelled
+struct TimerHandle {
+    std::uint32_t node = ~std::uint32_t(0);
+    std::uint32_t generation = 0;
+};
+
+/// \brief Hierarchical timing wheel of events of the types of \c P, each kept
+/// as its index in \c P and an inline copy in a node of a fixed pool
+///
+/// \c Levels wheels of 256 slots, level \c L covers deadlines that differ
+/// from the current time from the bit 8L on; their slots cascade into the
+/// level below when the time reaches them.  Scheduling and cancelling are
+/// O(1): the slots are doubly linked lists of pool nodes.  \c advance fires
+/// whole slots to a \c Sink_t; occupancy bitmaps of every level let it skip
+/// the empty slots, thus calling it on every iteration of a busy poll loop is
+/// cheap, and so is a jump far ahead
+/// \note deadlines beyond the range of the wheels wait in the top level and
+/// are placed again each revolution
+template<typename P, std::size_t Levels = 4>
+class TimerWheel {
+    static_assert(1 < Levels && Levels < 8, "From 2 levels to 7");
+
+    using Layout = detail::PayloadLayout<P>;
+    constexpr static std::uint32_t Nil = ~std::uint32_t(0);
+    constexpr static std::size_t Slots = 256, Bits = 8;
+
+    struct alignas(Layout::alignment) Node {
+        unsigned char payload[Layout::size];
+        std::uint64_t deadline;
+        std::size_t index;
+        std::uint32_t previous, next;
+        std::uint32_t bucket; ///< level * Slots + slot, \c Nil if unscheduled
+        std::uint32_t generation;
+    };
+
+    std::vector<Node> nodes_;
+    std::uint32_t free_;
+    std::size_t count_ = 0;
+    std::uint64_t now_;
+    std::uint32_t heads_[Levels * Slots];
+    /// \brief the buckets with timers
+    std::uint64_t occupied_[Levels * Slots / 64] = {};
+
+    void link(std::uint32_t n, std::uint32_t bucket) {
+        auto &node = nodes_[n];
+        node.bucket = bucket;
+        node.previous = Nil;
+        node.next = heads_[bucket];
+        if(Nil != node.next) { nodes_[node.next].previous = n; }
+        heads_[bucket] = n;
+        occupied_[bucket / 64] |= 1ull << (bucket % 64);
+    }
+
+    void unlink(std::uint32_t n) {
+        auto &node = nodes_[n];
+        auto bucket = node.bucket;
+        if(Nil != node.previous) { nodes_[node.previous].next = node.next; }
+        else { heads_[bucket] = node.next; }
+        if(Nil != node.next) { nodes_[node.next].previous = node.previous; }
+        node.bucket = Nil;
+        if(Nil == heads_[bucket]) {
+            occupied_[bucket / 64] &= ~(1ull << (bucket % 64));
+        }
+    }
+
+    /// \brief the lowest level where the deadline and the current time agree
+    /// on all of the higher bits, not earlier than \c earliest
+    void place(std::uint32_t n, std::uint64_t earliest) {
+        auto deadline = std::max(nodes_[n].deadline, earliest);
+        for(std::size_t level = 0; level + 1 < Levels; ++level) {
+            auto above = Bits * (level + 1);
+            if((deadline >> above) == (now_ >> above)) {
+                auto digit = (deadline >> (Bits * level)) % Slots;
+                link(n, std::uint32_t(level * Slots + digit));
+                return;
+            }
+        }
+        // the top level slots cascade the next time the time reaches them,
+        // thus any deadline within a revolution goes to its own slot; later
+        // ones to the slot reached last, to be placed again from there
+        auto shift = Bits * (Levels - 1);
+        auto digit =
+            (deadline - now_) >> (Bits * Levels) ?
+                ((now_ >> shift) + Slots - 1) % Slots :
+                (deadline >> shift) % Slots;
+        link(n, std::uint32_t((Levels - 1) * Slots + digit));
+    }
+
+    void release(std::uint32_t n) {
+        auto &node = nodes_[n];
+        ++node.generation;
+        node.next = free_;
+        free_ = n;
+        --count_;
+    }
+
+    template<typename Sink>
+    std::size_t fire(std::size_t slot, Sink &sink) {
+        std::size_t fired = 0;
+        while(Nil != heads_[slot]) {
+            auto n = heads_[slot];
+            unlink(n);
+            // the node is not reused until released, the sink may schedule
+            // and cancel
+            sink(
+                static_cast<const void *>(nodes_[n].payload), nodes_[n].index
+            );
+            release(n);
+            ++fired;
+        }
+        return fired;
+    }
+
+    /// \brief moves the timers of the slots the time reached to lower levels
+    void cascade() {
+        for(auto level = Levels; --level; ) {
+            auto shift = Bits * level;
+            if(now_ & ((std::uint64_t(1) << shift) - 1)) { continue; }
+            auto bucket = level * Slots + (now_ >> shift) % Slots;
+            auto n = heads_[bucket];
+            heads_[bucket] = Nil;
+            occupied_[bucket / 64] &= ~(1ull << (bucket % 64));
+            while(Nil != n) {
+                auto next = nodes_[n].next;
+                place(n, now_); // fires in this very tick if due
+                n = next;
+            }
+        }
+    }
+
+    /// \brief the first occupied slot of \c level in [from, to], \c Slots if
+    /// none
+    std::size_t
+    nextOccupied(std::size_t level, std::size_t from, std::size_t to) const {
+        auto words = occupied_ + level * (Slots / 64);
+        for(auto word = from / 64; word <= to / 64; ++word) {
+            auto bits = words[word];
+            if(word == from / 64) { bits &= ~0ull << (from % 64); }
+            if(bits) {
+                auto slot = word * 64 + std::size_t(__builtin_ctzll(bits));
+                return slot <= to ? slot : Slots;
+            }
+        }
+        return Slots;
+    }
+
+    /// \brief the first time after the current that reaches an occupied slot
+    /// of a level above 0, when level 0 is empty
+    /// \note the occupied slots of a level are ahead of its current digit,
+    /// except in the top level, whose slots up to it wait for the next
+    /// revolution
+    std::uint64_t nextReached() const {
+        auto rv = std::numeric_limits<std::uint64_t>::max();
+        for(std::size_t level = 1; level < Levels; ++level) {
+            auto shift = Bits * level;
+            auto unit = now_ >> shift;
+            auto digit = unit % Slots;
+            auto revolution = unit - digit;
+            auto slot =
+                Slots - 1 == digit ? Slots :
+                    nextOccupied(level, digit + 1, Slots - 1);
+            if(Slots == slot && Levels - 1 == level) {
+                slot = nextOccupied(level, 0, digit);
+                revolution += Slots;
+            }
+            if(Slots != slot) {
+                rv = std::min(rv, (revolution + slot) << shift);
+            }
+        }
+        return rv;
+    }
+
+public:
+    explicit TimerWheel(std::size_t capacity, std::uint64_t now = 0):
+        nodes_(capacity), free_(capacity ? 0 : Nil), now_(now)
+    {
+        for(std::size_t i = 0; i < capacity; ++i) {
+            nodes_[i].next = i + 1 < capacity ? std::uint32_t(i + 1) : Nil;
+            nodes_[i].bucket = Nil;
+            nodes_[i].generation = 0;
+        }
+        std::fill(std::begin(heads_), std::end(heads_), Nil);
+    }
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /// \brief \c event fires on the first \c advance to \c deadline or later
+    /// \return a handle with \c Nil node if the pool is exhausted
+    template<typename Event>
+    TimerHandle schedule(std::uint64_t deadline, const Event &event) {
+        if(Nil == free_) { return {}; }
+        auto n = free_;
+        auto &node = nodes_[n];
+        free_ = node.next;
+        std::memcpy(node.payload, &event, sizeof(Event));
+        node.index = IndexOf_v<Event, P>;
+        node.deadline = deadline;
+        ++count_;
+        place(n, now_ + 1);
+        return { n, node.generation };
+    }
+
+    /// \return whether the timer was still pending
+    bool cancel(TimerHandle h) {
+        if(Nil == h.node) { return false; }
+        auto &node = nodes_[h.node];
+        if(node.generation != h.generation || Nil == node.bucket) {
+            return false;
+        }
+        unlink(h.node);
+        release(h.node);
+        return true;
+    }
+
+    /// \brief Moves the time to \c to firing what expires
+    /// \return how many fired
+    template<typename Sink>
+    std::size_t advance(std::uint64_t to, Sink &&sink) {
+        static_assert(IsSink_v<Sink>, "Not callable as a meta::Sink_t");
+        std::size_t fired = 0;
+        while(now_ < to) {
+            if(!count_) { now_ = to; break; }
+            auto boundary = (now_ | (Slots - 1)) + 1;
+            auto last = std::min(to, boundary - 1);
+            while(now_ < last) {
+                auto slot = nextOccupied(0, (now_ + 1) % Slots, last % Slots);
+                if(Slots == slot) { break; }
+                now_ = (now_ & ~std::uint64_t(Slots - 1)) + slot;
+                fired += fire(slot, sink);
+            }
+            now_ = last;
+            if(to == last) { break; }
+            // level 0 is empty up to the boundary, nothing happens until the
+            // time reaches an occupied slot above
+            auto next = std::max(boundary, nextReached());
+            if(to < next) { now_ = to; break; }
+            now_ = next;
+            cascade();
+            fired += fire(0, sink);
+        }
+        return fired;
+    }
+
+    std::uint64_t now() const noexcept { return now_; }
+    std::size_t size() const noexcept { return count_; }
+};
+
+}
+
+#endif
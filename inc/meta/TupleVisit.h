@@ -0,0 +1,174 @@
+#ifndef ZOO_META_TUPLE_VISIT
+#define ZOO_META_TUPLE_VISIT
+
+#include <meta/Instantiator.h>
+
+#ifndef SIMPLIFY_PREPROCESSING
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace meta {
+namespace detail {
+
+template<typename Tuple, typename Visitor>
+struct TupleVisitor {
+    using return_t =
+        decltype(
+            std::declval<Visitor &>()(std::get<0>(std::declval<Tuple &>()))
+        );
+
+    template<std::size_t Index>
+    struct Element {
+        static return_t execute(Tuple &tuple, Visitor &visitor) {
+            return visitor(std::get<Index>(tuple));
+        }
+    };
+};
+
+template<typename Tuple>
+struct TupleElementAddress {
+    using pointer_t =
+        std::conditional_t<std::is_const<Tuple>::value, const void *, void *>;
+
+    template<std::size_t Index>
+    struct Element {
+        static pointer_t execute(Tuple &tuple) {
+            return &std::get<Index>(tuple);
+        }
+    };
+};
+
+/// \brief The distance of each element from the first, in elements, of a
+/// homogeneous tuple built in a constant expression
+/// \note a constant expression only if the compiler evaluates the difference
+/// of the addresses of distinct members, as GCC does, and if the elements
+/// are constexpr default constructible
+template<typename Tuple, std::size_t... Indices>
+constexpr std::array<std::ptrdiff_t, sizeof...(Indices)>
+tupleOffsets(std::index_sequence<Indices...>) {
+    Tuple sample{};
+    return {{ (&std::get<Indices>(sample) - &std::get<0>(sample))... }};
+}
+
+template<typename Tuple>
+using TupleIndices_t = std::make_index_sequence<std::tuple_size<Tuple>::value>;
+
+template<typename Tuple, typename = void>
+struct ConstantTupleOffsets: std::false_type {};
+
+template<typename Tuple>
+struct ConstantTupleOffsets<
+    Tuple,
+    std::enable_if_t<
+        // uses the result, thus evaluates the differences
+        0 == tupleOffsets<Tuple>(TupleIndices_t<Tuple>())[0]
+    >
+>: std::true_type {};
+
+template<typename Tuple, typename = void>
+struct TupleOffsets: std::false_type {};
+
+// the element type is checked first, building the sample of a type not
+// default constructible or not trivially destructible is an error, not a
+// substitution failure
+template<typename Tuple>
+struct TupleOffsets<
+    Tuple,
+    std::enable_if_t<
+        std::is_default_constructible<std::tuple_element_t<0, Tuple>>::value
+        &&
+        std::is_trivially_destructible<std::tuple_element_t<0, Tuple>>::value
+    >
+>: ConstantTupleOffsets<Tuple> {};
+
+template<typename Tuple, typename Indices>
+struct HomogeneousTuple: std::false_type {};
+
+template<typename Tuple, std::size_t... Indices>
+struct HomogeneousTuple<Tuple, std::index_sequence<0, Indices...>>:
+    std::integral_constant<
+        bool,
+        (std::is_same<
+            std::tuple_element_t<0, Tuple>,
+            std::tuple_element_t<Indices, Tuple>
+        >::value && ...)
+    >
+{};
+
+}
+
+/// \brief Calls \c visitor with the element \c index of \c tuple, through an
+/// \c Instantiator jump table; all the calls must return the same type
+template<typename Tuple, typename Visitor>
+decltype(auto) visitAt(Tuple &tuple, std::size_t index, Visitor &&visitor) {
+    using Implementation =
+        detail::TupleVisitor<Tuple, std::remove_reference_t<Visitor>>;
+    return Instantiator<
+        Implementation::template Element,
+        std::tuple_size<std::remove_const_t<Tuple>>::value,
+        typename Implementation::return_t(
+            Tuple &, std::remove_reference_t<Visitor> &
+        )
+    >::execute(tuple, visitor, index);
+}
+
+/// \brief The address of the element \c index of any tuple, such as
+/// <tt>std::tuple<State<Ts>...></tt>, through an \c Instantiator jump table
+/// whose entries are the address of the tuple plus a constant
+/// \note the offsets of a tuple of different types can not be computed in
+/// constant expressions, the standard defines the difference of addresses
+/// only within an array
+template<typename Tuple>
+auto elementAddress(Tuple &tuple, std::size_t index) {
+    using Implementation = detail::TupleElementAddress<Tuple>;
+    return Instantiator<
+        Implementation::template Element,
+        std::tuple_size<std::remove_const_t<Tuple>>::value,
+        typename Implementation::pointer_t(Tuple &)
+    >::execute(tuple, index);
+}
+
+/// \brief Whether \c elementAt applies: all elements of the same type
+template<typename Tuple>
+constexpr bool HomogeneousTuple_v =
+    detail::HomogeneousTuple<
+        Tuple, std::make_index_sequence<std::tuple_size<Tuple>::value>
+    >::value;
+
+/// \brief The element \c index of a tuple whose elements are all the same
+/// type: one load from a \c constexpr table of the distances of the elements
+/// from the first when the compiler can compute it, else \c elementAddress
+/// \note the distances are differences of addresses of distinct members,
+/// GCC evaluates them in constant expressions, Clang does not; elements
+/// whose default constructor is not \c constexpr also fall back
+template<typename Tuple>
+auto &elementAt(Tuple &tuple, std::size_t index) {
+    using Plain = std::remove_const_t<Tuple>;
+    static_assert(HomogeneousTuple_v<Plain>, "Not a homogeneous tuple");
+    using Element = std::tuple_element_t<0, Plain>;
+    using Qualified =
+        std::conditional_t<std::is_const<Tuple>::value, const Element, Element>;
+    if constexpr(detail::TupleOffsets<Plain>::value) {
+        constexpr static auto offsets =
+            detail::tupleOffsets<Plain>(detail::TupleIndices_t<Plain>());
+        return *(&std::get<0>(tuple) + offsets[index]);
+    } else {
+        return *static_cast<Qualified *>(elementAddress(tuple, index));
+    }
+}
+
+/// \brief Whether \c elementAt on \c Tuple is a load from a table of offsets
+template<typename Tuple>
+constexpr bool TabulatedTuple_v =
+    std::conjunction<
+        std::bool_constant<HomogeneousTuple_v<Tuple>>,
+        detail::TupleOffsets<Tuple>
+    >::value;
+
+}
+
+#endif
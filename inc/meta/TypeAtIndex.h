@@ -6,25 +6,45 @@
 #endif
 
 #include <meta/Pack.h>
+#include <meta/Indices.h>
 
 namespace meta {
 namespace detail {
 
-template<std::size_t Remaining, typename Head, typename... Tail>
-struct TypeAtIndexByRemaining {
-    using type = typename TypeAtIndexByRemaining<Remaining - 1, Tail...>::type;
+template<std::size_t Index, typename T>
+struct IndexedType {
+    using type = T;
 };
 
-template<typename Head, typename... Tail>
-struct TypeAtIndexByRemaining<0, Head, Tail...> {
-    using type = Head;
-};
+/// \brief Inherits from <tt>IndexedType<I, T_I></tt> for each element, to
+/// look up any of them by overload resolution instead of recursion
+template<typename, typename... Ts>
+struct IndexedTypes;
+
+template<std::size_t... Indices, typename... Ts>
+struct IndexedTypes<IndexPack<std::size_t, Indices...>, Ts...>:
+    IndexedType<Indices, Ts>...
+{};
+
+template<std::size_t Index, typename T>
+IndexedType<Index, T> typeAtIndex(const IndexedType<Index, T> *);
 
 }
 
 template<std::size_t Index, typename... Ts>
 struct TypeAtIndex {
-    using type = typename detail::TypeAtIndexByRemaining<Index, Ts...>::type;
+    static_assert(Index < sizeof...(Ts), "Index out of range");
+
+    using type =
+        typename decltype(
+            detail::typeAtIndex<Index>(
+                static_cast<
+                    detail::IndexedTypes<
+                        MakeIndexPack<std::size_t, sizeof...(Ts)>, Ts...
+                    > *
+                >(nullptr)
+            )
+        )::type;
 };
 
 template<std::size_t Index, typename... Ts>
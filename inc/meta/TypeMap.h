@@ -0,0 +1,46 @@
+#ifndef ZOO_META_TYPE_MAP
+#define ZOO_META_TYPE_MAP
+
+#include <meta/IndexOf.h>
+#include <meta/PackAlgorithms.h>
+
+namespace meta {
+
+template<typename Key, typename Value>
+struct Pair {
+    using key = Key;
+    using value = Value;
+};
+
+/// \brief Compile-time map from types to types, the values may be
+/// \c std::integral_constant to map types to values such as wire ids
+/// \note Repeating a key and looking up a key absent are errors
+template<typename Pairs>
+struct TypeMap;
+
+template<typename... Keys, typename... Values>
+struct TypeMap<Pack<Pair<Keys, Values>...>> {
+    static_assert(
+        std::is_same<Unique_t<Pack<Keys...>>, Pack<Keys...>>::value,
+        "Repeated key"
+    );
+
+    using keys_t = Pack<Keys...>;
+    using values_t = Pack<Values...>;
+
+    template<typename Key>
+    constexpr static bool contains =
+        (false || ... || std::is_same<Key, Keys>::value);
+
+    /// \note \c void is appended so that a failed lookup only reports the
+    /// \c IndexOf diagnostic
+    template<typename Key>
+    using At = TypeAtIndex_t<IndexOf_v<Key, Keys...>, Values..., void>;
+
+    template<typename Key>
+    constexpr static auto value = At<Key>::value;
+};
+
+}
+
+#endif
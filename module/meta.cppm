@@ -0,0 +1,46 @@
+/// \file meta.cppm
+/// C++20 module interface unit of the library, exporting the compile time
+/// components: the packs and their algorithms, the dispatch and the layout
+/// hash.  The runtime components (rings, timer wheel, conflator and the
+/// like) are used through \c meta/Meta.h or its precompiled header, GCC 12
+/// miscompiles some of them through a module.  The standard headers go in
+/// the global module fragment, so their include guards keep them out of the
+/// purview.  Macros can not be exported: the shard translation units of a
+/// \c ShardedInstantiator still include \c meta/ShardedInstantiatorShard.h,
+/// and importers declaring \c LayoutFields spell out the \c Field that
+/// \c ZOO_META_FIELD makes.  Built by <tt>make module</tt>;
+/// \c test/rebuild_cost.sh includes the headers listed here textually to
+/// compare with importing them
+
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+export module meta;
+
+export {
+#include <meta/Pack.h>
+#include <meta/IndexPack.h>
+#include <meta/Indices.h>
+#include <meta/IndexPackAlgorithms.h>
+#include <meta/TypeAtIndex.h>
+#include <meta/IndexOf.h>
+#include <meta/TypeMap.h>
+#include <meta/PackAlgorithms.h>
+#include <meta/PackUnion.h>
+#include <meta/InternedPack.h>
+#include <meta/PackIndexer.h>
+#include <meta/InplaceType.h>
+#include <meta/NotBasedOn.h>
+#include <meta/Instantiator.h>
+#include <meta/ShardedInstantiator.h>
+#include <meta/Table.h>
+#include <meta/TupleVisit.h>
+#include <meta/LayoutHash.h>
+#include <meta/Sink.h>
+}
@@ -0,0 +1,121 @@
+#ifndef ZOO_META_TEST_MARKET_DATA
+#define ZOO_META_TEST_MARKET_DATA
+
+/// \file MarketData.h
+/// Seeded synthetic streams of the \c OrderBook.h messages, as records the
+/// dispatch takes, in the proportions a benchmark describes.
+
+#include "OrderBook.h"
+
+#include <meta/IndexOf.h>
+#include <meta/Instantiator.h>
+#include <meta/PackIndexer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace book {
+
+/// \brief A message of \c MessageTypeArray as the dispatch takes it
+struct Record {
+    std::size_t index;
+    alignas(8) unsigned char bytes[24];
+};
+
+template<typename Message>
+Record record(const Message &m) {
+    static_assert(sizeof(Message) <= sizeof(Record::bytes), "");
+    Record rv;
+    rv.index = meta::IndexOf_v<Message, MessageTypeArray>;
+    std::memcpy(rv.bytes, &m, sizeof(m));
+    return rv;
+}
+
+/// \brief every message starts with its instrument
+inline std::uint32_t instrument(const Record &r) {
+    std::uint32_t rv;
+    std::memcpy(&rv, r.bytes, sizeof(rv));
+    return rv;
+}
+
+/// \brief The relative frequencies of the types of a synthetic stream, in
+/// the order of \c MessageTypeArray, and the ticks from the mid over which
+/// the depth quotes spread
+struct MarketMix {
+    unsigned weights[10];
+    Price depth;
+};
+
+namespace detail {
+
+using Random = std::mt19937_64;
+
+/// \brief top quotes are a tick away from the mid, depth quotes up to the
+/// depth of the mix, with quantity 0 deleting the level
+template<typename> struct Synthetic;
+
+template<bool Top, QuoteSide S, LiquidityProvider LP>
+struct Synthetic<Quote<Top, S, LP>> {
+    static Record
+    execute(std::uint32_t instrument, Price &mid, Random &random, Price depth) {
+        auto q = Quantity(random() % 50) + Top;
+        auto away = Top ? 1 : 1 + Price(random() % depth);
+        return record(Quote<Top, S, LP>{
+            instrument, q, BID == S ? mid - away : mid + away
+        });
+    }
+};
+
+/// \brief trades walk the mid
+template<> struct Synthetic<Trade> {
+    static Record
+    execute(std::uint32_t instrument, Price &mid, Random &random, Price) {
+        auto q = Quantity(random() % 50) + 1;
+        mid += Price(random() % 3) - 1;
+        return record(Trade{instrument, q, mid});
+    }
+};
+
+template<> struct Synthetic<Uptick> {
+    static Record execute(std::uint32_t instrument, Price &, Random &, Price) {
+        return record(Uptick{instrument});
+    }
+};
+
+}
+
+/// \brief \c count messages over \c instruments in the proportions of
+/// \c mix, reproducible by \c seed
+inline std::vector<Record> marketData(
+    std::size_t count, std::uint32_t instruments, const MarketMix &mix,
+    std::uint64_t seed
+) {
+    using Synthesize = meta::Instantiator<
+        meta::PackIndexer<detail::Synthetic, MessageTypeArray>::Internal,
+        10,
+        Record(std::uint32_t, Price &, detail::Random &, Price)
+    >;
+    unsigned total = 0;
+    for(auto w: mix.weights) { total += w; }
+    detail::Random random(seed);
+    std::vector<Price> mid(instruments, 100000);
+    std::vector<Record> rv;
+    rv.reserve(count);
+    while(rv.size() < count) {
+        auto instrument = std::uint32_t(random() % instruments);
+        auto dice = unsigned(random() % total);
+        std::size_t index = 0;
+        while(mix.weights[index] <= dice) { dice -= mix.weights[index++]; }
+        rv.push_back(Synthesize::execute(
+            instrument, mid[instrument], random, mix.depth, index
+        ));
+    }
+    return rv;
+}
+
+}
+
+#endif
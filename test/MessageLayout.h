@@ -0,0 +1,37 @@
+#ifndef ZOO_META_TEST_MESSAGE_LAYOUT
+#define ZOO_META_TEST_MESSAGE_LAYOUT
+
+/// \file MessageLayout.h
+/// The members of the \c OrderBook.h messages their layout handshakes cover.
+/// Both sides of a handshake include this before taking the \c LayoutHash of
+/// the messages, without it the hash covers only their names, sizes and
+/// alignments.
+
+#include "OrderBook.h"
+
+#include <meta/LayoutHash.h>
+
+#include <cstddef>
+
+template<bool Top, book::QuoteSide S, book::LiquidityProvider LP>
+struct meta::LayoutFields<book::Quote<Top, S, LP>> {
+    using Q = book::Quote<Top, S, LP>;
+    using type = Pack<
+        ZOO_META_FIELD(Q, instrument), ZOO_META_FIELD(Q, quantity),
+        ZOO_META_FIELD(Q, price)
+    >;
+};
+
+template<> struct meta::LayoutFields<book::Trade> {
+    using T = book::Trade;
+    using type = Pack<
+        ZOO_META_FIELD(T, instrument), ZOO_META_FIELD(T, quantity),
+        ZOO_META_FIELD(T, price)
+    >;
+};
+
+template<> struct meta::LayoutFields<book::Uptick> {
+    using type = Pack<ZOO_META_FIELD(book::Uptick, instrument)>;
+};
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef ZOO_META_TEST_ORDER_BOOK
+#define ZOO_META_TEST_ORDER_BOOK
+
+/// \file OrderBook.h
+/// Reference consumer of the dispatch in \c instantiator_demo.cpp: per
+/// instrument books with separate outright and implied depth, driven by the
+/// \c Quote<TopOfTheBook, Side, LiquidityProvider> messages.
+
+#include <meta/PackIndexer.h>
+#include <meta/Instantiator.h>
+#include <meta/Seqlock.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace book {
+
+enum QuoteSide {
+    BID, ASK
+};
+
+enum LiquidityProvider {
+    OUTRIGHT,
+    IMPLIED
+};
+
+using Price = std::int64_t; ///< in ticks
+using Quantity = std::int32_t;
+
+template<
+    bool TopOfTheBook,
+    QuoteSide S,
+    LiquidityProvider LP
+>
+struct Quote {
+    std::uint32_t instrument;
+    Quantity quantity; ///< 0 deletes the level
+    Price price;
+};
+
+struct Trade {
+    std::uint32_t instrument;
+    Quantity quantity;
+    Price price;
+};
+
+struct Uptick {
+    std::uint32_t instrument;
+};
+
+using MessageTypeArray =
+    Pack<
+        Quote<false, BID, OUTRIGHT>,
+        Quote<false, BID, IMPLIED>,
+        Quote<false, ASK, OUTRIGHT>,
+        Quote<false, ASK, IMPLIED>,
+        Quote<true, BID, OUTRIGHT>,
+        Quote<true, BID, IMPLIED>,
+        Quote<true, ASK, OUTRIGHT>,
+        Quote<true, ASK, IMPLIED>,
+        Trade,
+        Uptick
+    >;
+
+/// \brief Price levels of one side in a flat array indexed by the distance in
+/// ticks from \c anchor_ towards the less aggressive prices, thus index 0 is
+/// the most aggressive price representable and the best level is the lowest
+/// index with quantity
+template<QuoteSide S>
+class Ladder {
+    Price anchor_ = 0;
+    std::size_t best_;
+    std::vector<Quantity> quantities_;
+
+    std::ptrdiff_t index(Price p) const {
+        return BID == S ? anchor_ - p : p - anchor_;
+    }
+
+    Price price(std::size_t index) const {
+        auto i = Price(index);
+        return BID == S ? anchor_ - i : anchor_ + i;
+    }
+
+    void recenter(Price around) {
+        std::vector<Quantity> old(quantities_.size(), 0);
+        old.swap(quantities_);
+        auto oldAnchor = anchor_;
+        auto half = Price(quantities_.size() / 2);
+        anchor_ = BID == S ? around + half : around - half;
+        best_ = quantities_.size();
+        for(std::size_t i = 0; i < old.size(); ++i) {
+            if(!old[i]) { continue; }
+            auto p = BID == S ? oldAnchor - Price(i) : oldAnchor + Price(i);
+            auto ndx = index(p);
+            if(ndx < 0 || quantities_.size() <= std::size_t(ndx)) {
+                continue;
+            }
+            quantities_[ndx] = old[i];
+            if(std::size_t(ndx) < best_) { best_ = ndx; }
+        }
+    }
+
+    void findBestFrom(std::size_t from) {
+        while(from < quantities_.size() && !quantities_[from]) { ++from; }
+        best_ = from;
+    }
+
+public:
+    explicit Ladder(std::size_t ticks = 4096):
+        best_(ticks), quantities_(ticks, 0)
+    {}
+
+    bool empty() const { return quantities_.size() == best_; }
+    Price bestPrice() const { return price(best_); }
+    Quantity bestQuantity() const { return quantities_[best_]; }
+
+    Quantity at(Price p) const {
+        auto ndx = index(p);
+        if(ndx < 0 || std::size_t(ndx) >= quantities_.size()) { return 0; }
+        return quantities_[ndx];
+    }
+
+    /// \brief general path, any level
+    /// \note a level deeper than the width of the ladder from the best is not
+    /// kept, the best never is lost for it
+    void update(Price p, Quantity q) {
+        auto ndx = index(p);
+        if(ndx < 0 || std::size_t(ndx) >= quantities_.size()) {
+            if(!q) { return; }
+            // around the best if p is on the passive side, between both if
+            // it is the new best, around p if that loses the best anyway
+            recenter(
+                empty() ? p : 0 <= ndx ? bestPrice() : (p + bestPrice()) / 2
+            );
+            ndx = index(p);
+            if(ndx < 0) {
+                recenter(p);
+                ndx = index(p);
+            }
+            if(std::size_t(ndx) >= quantities_.size()) { return; }
+        }
+        auto i = std::size_t(ndx);
+        quantities_[i] = q;
+        if(q) {
+            if(i < best_) { best_ = i; }
+        } else if(i == best_) {
+            findBestFrom(i + 1);
+        }
+    }
+
+    /// \brief dedicated path of the top of the book messages: the level
+    /// becomes the best, the more aggressive levels are gone
+    void updateTop(Price p, Quantity q) {
+        auto ndx = index(p);
+        if(ndx < 0 || std::size_t(ndx) >= quantities_.size()) {
+            recenter(p);
+            ndx = index(p);
+        }
+        auto i = std::size_t(ndx);
+        for(auto j = empty() ? i : best_; j < i; ++j) { quantities_[j] = 0; }
+        quantities_[i] = q;
+        if(q) { best_ = i; }
+        else { findBestFrom(i + 1); }
+    }
+};
+
+template<QuoteSide S>
+struct Side {
+    Ladder<S> depth[2]; ///< indexed by \c LiquidityProvider
+
+    /// \brief the best of outright and implied
+    Price bestPrice() const {
+        auto &o = depth[OUTRIGHT], &i = depth[IMPLIED];
+        if(o.empty()) { return i.bestPrice(); }
+        if(i.empty()) { return o.bestPrice(); }
+        auto op = o.bestPrice(), ip = i.bestPrice();
+        return BID == S ? (ip < op ? op : ip) : (op < ip ? op : ip);
+    }
+
+    /// \brief outright plus implied at the best price, 0 if empty
+    Quantity bestQuantity() const {
+        auto &o = depth[OUTRIGHT], &i = depth[IMPLIED];
+        if(o.empty() && i.empty()) { return 0; }
+        auto p = bestPrice();
+        return o.at(p) + i.at(p);
+    }
+};
+
+/// \brief What strategy threads read of an instrument, a quantity of 0 means
+/// the side is empty
+struct TopOfBook {
+    Price bid = 0, ask = 0;
+    Quantity bidQuantity = 0, askQuantity = 0;
+};
+
+struct InstrumentBook {
+    Side<BID> bids;
+    Side<ASK> asks;
+    Quantity tradedVolume = 0;
+    Price lastTrade = 0;
+    std::uint32_t upticks = 0;
+    /// \brief published by the top of the book quotes for other threads
+    meta::Seqlock<TopOfBook> top;
+
+    template<QuoteSide S>
+    Side<S> &side() {
+        if constexpr(BID == S) { return bids; } else { return asks; }
+    }
+
+    void publishTop() {
+        TopOfBook t;
+        t.bidQuantity = bids.bestQuantity();
+        t.askQuantity = asks.bestQuantity();
+        if(t.bidQuantity) { t.bid = bids.bestPrice(); }
+        if(t.askQuantity) { t.ask = asks.bestPrice(); }
+        top.store(t);
+    }
+};
+
+struct Books {
+    std::vector<InstrumentBook> instruments;
+
+    explicit Books(std::size_t count): instruments(count) {}
+};
+
+template<bool TopOfTheBook, QuoteSide S, LiquidityProvider LP>
+void processMarketMessage(Books &books, const Quote<TopOfTheBook, S, LP> &q) {
+    InstrumentBook &instrument = books.instruments[q.instrument];
+    auto &ladder = instrument.side<S>().depth[LP];
+    if constexpr(TopOfTheBook) {
+        ladder.updateTop(q.price, q.quantity);
+        instrument.publishTop();
+    } else { ladder.update(q.price, q.quantity); }
+}
+
+inline void processMarketMessage(Books &books, const Trade &t) {
+    auto &instrument = books.instruments[t.instrument];
+    instrument.tradedVolume += t.quantity;
+    instrument.lastTrade = t.price;
+}
+
+inline void processMarketMessage(Books &books, const Uptick &u) {
+    ++books.instruments[u.instrument].upticks;
+}
+
+template<typename Message>
+struct BookProcessor {
+    static void execute(Books &books, const void *message) {
+        processMarketMessage(books, *static_cast<const Message *>(message));
+    }
+};
+
+inline void process(Books &books, const void *message, std::size_t index) {
+    meta::Instantiator<
+        meta::PackIndexer<BookProcessor, MessageTypeArray>::Internal,
+        10,
+        void(Books &, const void *)
+    >::execute(books, message, index);
+}
+
+}
+
+#endif
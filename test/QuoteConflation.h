@@ -0,0 +1,28 @@
+#ifndef ZOO_META_TEST_QUOTE_CONFLATION
+#define ZOO_META_TEST_QUOTE_CONFLATION
+
+/// \file QuoteConflation.h
+/// The \c OrderBook.h messages a \c Conflator stages for a slow consumer.
+
+#include "OrderBook.h"
+
+#include <meta/Conflator.h>
+
+#include <type_traits>
+
+namespace book {
+
+/// \brief A top of the book quote carries the whole top of its side and
+/// provider, only the last one per instrument matters to a consumer that is
+/// behind.  Depth quotes, trades and upticks bypass the conflation
+/// \note bypassing messages reach the consumer ahead of the pending quotes
+template<typename> struct Conflated: std::false_type {};
+
+template<QuoteSide S, LiquidityProvider LP>
+struct Conflated<Quote<true, S, LP>>: std::true_type {};
+
+using QuoteConflator = meta::Conflator<MessageTypeArray, Conflated>;
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef ZOO_META_TEST_QUOTE_SHEDDING
+#define ZOO_META_TEST_QUOTE_SHEDDING
+
+/// \file QuoteShedding.h
+/// A \c SupersedingShedder in front of the \c OrderBook.h books, with the
+/// priorities of their messages and how their quotes supersede each other.
+
+#include "MarketData.h"
+
+#include <meta/SupersedingShedder.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace book {
+
+/// \brief The backlog level from which a message is shed, 0 never: the depth
+/// quotes first, then the top of the book quotes, both conflated into the
+/// pending quotes they supersede; trades and upticks are always delivered
+template<typename> struct SheddingPriority: std::integral_constant<int, 0> {};
+
+template<QuoteSide S, LiquidityProvider LP>
+struct SheddingPriority<Quote<false, S, LP>>:
+    std::integral_constant<int, 1>
+{};
+
+template<QuoteSide S, LiquidityProvider LP>
+struct SheddingPriority<Quote<true, S, LP>>: std::integral_constant<int, 2> {};
+
+/// \brief Depth quotes of an instrument commute with each other, a top of the
+/// book quote clears the more aggressive levels and publishes the top: it
+/// must not overtake the pending depth quotes, nor the pending top quote of
+/// its side and provider at another price.  Trades and upticks are not
+/// conflated
+template<typename> struct QuoteSupersession:
+    std::integral_constant<meta::Supersession, meta::Supersession::None>
+{};
+
+template<QuoteSide S, LiquidityProvider LP>
+struct QuoteSupersession<Quote<false, S, LP>>:
+    std::integral_constant<meta::Supersession, meta::Supersession::Commuting>
+{};
+
+template<QuoteSide S, LiquidityProvider LP>
+struct QuoteSupersession<Quote<true, S, LP>>:
+    std::integral_constant<meta::Supersession, meta::Supersession::Ordered>
+{};
+
+/// \brief \c SupersedingShedder in front of the books, the quotes grouped by
+/// instrument and superseded by price
+class QuoteShedder {
+    using Shedder = meta::SupersedingShedder<
+        MessageTypeArray, SheddingPriority, QuoteSupersession
+    >;
+
+    Shedder shedder_;
+
+public:
+    using Thresholds = Shedder::Thresholds;
+
+    QuoteShedder(const Thresholds &thresholds, std::uint32_t instruments):
+        shedder_(thresholds, instruments)
+    {}
+
+    template<typename Sink>
+    void backlog(std::size_t size, Sink &&sink) {
+        shedder_.backlog(size, sink);
+    }
+
+    template<typename Sink>
+    meta::Admission offer(const Record &r, Sink &&sink) {
+        Price p = 0;
+        if(meta::Supersession::None != Shedder::supersession(r.index)) {
+            using Q = Quote<false, BID, OUTRIGHT>; // all quotes are alike
+            std::memcpy(&p, r.bytes + offsetof(Q, price), sizeof(p));
+        }
+        return shedder_.offer(instrument(r), p, r.bytes, r.index, sink);
+    }
+
+    template<typename Sink>
+    void drain(Sink &&sink) { shedder_.drain(sink); }
+
+    std::size_t level() const noexcept { return shedder_.level(); }
+
+    std::uint64_t count(meta::Admission a) const noexcept {
+        return shedder_.count(a);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef ZOO_META_TEST_SHARDED_EMULATOR
+#define ZOO_META_TEST_SHARDED_EMULATOR
+
+/// \file ShardedEmulator.h
+/// The dispatcher of sharded_instantiator.cpp, whose shards are instantiated
+/// by sharded_instantiator_shard.cpp compiled once per shard
+
+#include <meta/ShardedInstantiator.h>
+
+template<std::size_t Opcode>
+struct Emulate {
+    static unsigned execute(unsigned accumulator) {
+        return accumulator * (Opcode | 1) + Opcode;
+    }
+};
+
+constexpr std::size_t Opcodes = 200;
+
+using Emulator =
+    meta::ShardedInstantiator<Emulate, Opcodes, 6, unsigned(unsigned)>;
+
+#endif
@@ -0,0 +1,97 @@
+/// \file async_logger.cpp
+/// Cost in the hot thread of logging the \c OrderBook.h messages it handles,
+/// with \c AsyncLogger formatting in the background into /dev/null against
+/// formatting with \c fprintf in the hot thread.  The calls come in bursts
+/// between which the hot thread is idle, as a feed handler between packets;
+/// only the bursts are timed.
+
+#include "OrderBook.h"
+
+#include <meta/AsyncLogger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace book;
+
+constexpr char quoteFormat[] = "quote %u side %d: %d at %lld\n";
+constexpr char tradeFormat[] = "trade %u: %d at %lld\n";
+constexpr char gapFormat[] = "gap of %llu after sequence %llu on %s\n";
+
+using QuoteSite = meta::LogSite<
+    quoteFormat, std::uint32_t, int, Quantity, long long
+>;
+using TradeSite =
+    meta::LogSite<tradeFormat, std::uint32_t, Quantity, long long>;
+using GapSite = meta::LogSite<
+    gapFormat, unsigned long long, unsigned long long, const char *
+>;
+
+using Sites = Pack<QuoteSite, TradeSite, GapSite>;
+
+constexpr std::size_t Burst = 1024;
+
+/// \brief the i-th call, to \c log with the site as the first argument
+template<typename Log>
+void call(std::size_t i, Log &&log) {
+    auto instrument = std::uint32_t(i % 64);
+    auto price = (long long)(100000 + i % 8);
+    switch(i % 8) {
+        case 7: log(TradeSite{}, instrument, Quantity(1), price); break;
+        case 6:
+            if(0 == i % 1024) {
+                log(GapSite{}, 3ull, (unsigned long long)i, "feed A");
+                break;
+            }
+            [[fallthrough]];
+        default: log(QuoteSite{}, instrument, int(i % 2), Quantity(10), price);
+    }
+}
+
+template<typename Log>
+double timeBursts(std::size_t count, Log &&log) {
+    using Clock = std::chrono::steady_clock;
+    Clock::duration hot{};
+    for(std::size_t i = 0; i < count; ) {
+        auto start = Clock::now();
+        for(auto end = std::min(count, i + Burst); i < end; ++i) {
+            call(i, log);
+        }
+        hot += Clock::now() - start;
+        // idle between packets, the background thread runs
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    return std::chrono::duration<double, std::nano>(hot).count() / count;
+}
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    auto out = std::fopen("/dev/null", "w");
+    if(!out) { return 1; }
+
+    std::uint64_t formatted, dropped;
+    double asyncCost;
+    {
+        meta::AsyncLogger<Sites> logger(out);
+        auto writer = logger.writer();
+        asyncCost = timeBursts(count, [&](auto site, auto... arguments) {
+            writer.log<decltype(site)>(arguments...);
+        });
+        formatted = logger.stop();
+        dropped = writer.dropped();
+    }
+    std::printf(
+        "AsyncLogger:      %5.1f ns/call, %llu formatted, %llu dropped\n",
+        asyncCost, (unsigned long long)formatted, (unsigned long long)dropped
+    );
+
+    auto syncCost = timeBursts(count, [&](auto site, auto... arguments) {
+        std::fprintf(out, decltype(site)::format, arguments...);
+    });
+    std::printf("fprintf in place: %5.1f ns/call\n", syncCost);
+    std::fclose(out);
+}
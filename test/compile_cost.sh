@@ -0,0 +1,20 @@
+#!/bin/sh
+# Front end time of the Pack algorithms, pack_algorithms_cost.cpp compiled
+# with -fsyntax-only for each algorithm and pack size.  From the repository
+# root: test/compile_cost.sh [counts...]
+# Unique sorts by type name hashes, 4096 types stay within the default
+# constexpr limit of GCC
+set -e
+CXX=${CXX:-g++}
+counts=${*:-"1024 2048"}
+for count in $counts; do
+    for algorithm in None Filter Unique SortBy Concat; do
+        start=$(date +%s%N)
+        $CXX -std=c++17 -fsyntax-only -Iinc -DCOUNT=$count \
+            -DALGORITHM=$algorithm test/pack_algorithms_cost.cpp
+        end=$(date +%s%N)
+        milliseconds=$(( (end - start) / 1000000 ))
+        printf '%5s types %-7s %d.%02ds\n' $count $algorithm \
+            $((milliseconds / 1000)) $((milliseconds % 1000 / 10))
+    done
+done
@@ -9,3 +9,468 @@ using namespace meta;
 static_assert(8 == sizeof(TypeAtIndex_t<0, long, char, int>), "");
 static_assert(8 == sizeof(TypeAtIndex_t<1, char, long, char, int>), "");
 static_assert(8 == sizeof(TypeAtIndex_t<3, char, int, char, long>), "");
+
+#include "meta/Indices.h"
+
+#ifndef NO_STANDARD_INCLUDES
+#include <type_traits>
+#endif
+
+static_assert(
+    std::is_same<IndexPack<unsigned long, 0, 1, 2>, Indices<2>>::value, ""
+);
+static_assert(std::is_same<IndexPack<int>, MakeIndexPack<int, 0>>::value, "");
+static_assert(
+    std::is_same<IndexPack<int, 0, 1, 2, 3>, MakeIndexPack<int, 4>>::value, ""
+);
+static_assert(
+    std::is_same<IndexPack<int, 5, 8, 11>, MakeIndexPack<int, 3, 5, 3>>::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        IndexPack<long, 0, 1, 2, 3, 4, 5, 6>,
+        detail::Iota<long, 7>::type
+    >::value,
+    ""
+);
+static_assert(5001 == Indices<5000>::arity, "");
+static_assert(5000 == detail::Iota<unsigned, 5000>::type::arity, "");
+static_assert(
+    std::is_same<
+        std::index_sequence<0, 1, 2>,
+        ToIntegerSequence_t<MakeIndexPack<std::size_t, 3>>
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        MakeIndexPack<int, 10>,
+        FromIntegerSequence_t<std::make_integer_sequence<int, 10>>
+    >::value,
+    ""
+);
+
+#include "meta/IndexPackAlgorithms.h"
+
+using Keys = IndexPack<int, 7, 3, 9, 3, 1, 7>;
+
+static_assert(9 == ValueAtIndex_v<2, Keys>, "");
+static_assert(6 == Array_v<Keys>.size() && 1 == Array_v<Keys>[4], "");
+static_assert(
+    std::is_same<IndexPack<int, 3, 9>, Slice_t<Keys, 1, 3>>::value, ""
+);
+static_assert(std::is_same<IndexPack<int>, Slice_t<Keys, 2, 2>>::value, "");
+static_assert(
+    std::is_same<IndexPack<int, 7, 1, 3, 9, 3, 7>, Reverse_t<Keys>>::value, ""
+);
+static_assert(
+    std::is_same<
+        IndexPack<int, 1, 2, 3, 4>,
+        ConcatValues_t<
+            IndexPack<int, 1>, IndexPack<int>, IndexPack<int, 2, 3, 4>
+        >
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<IndexPack<int, 1, 3, 3, 7, 7, 9>, Sort_t<Keys>>::value, ""
+);
+static_assert(
+    std::is_same<IndexPack<int, 7, 3, 9, 1>, UniqueValues_t<Keys>>::value, ""
+);
+static_assert(
+    std::is_same<IndexPack<int, 7, 3, 9, 1>, Unique_t<Keys>>::value, ""
+);
+static_assert(
+    std::is_same<
+        IndexPack<int, 7, 10, 19, 22, 23, 30>, InclusiveScan_t<Keys>
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        IndexPack<int, 0, 7, 10, 19, 22, 23>, ExclusiveScan_t<Keys>
+    >::value,
+    ""
+);
+static_assert(1 == Find_v<Keys, 3> && 6 == Find_v<Keys, 4>, "");
+static_assert(ContainsValue_v<Keys, 9> && !ContainsValue_v<Keys, 8>, "");
+static_assert(3 == LowerBound_v<Sort_t<Keys>, 5>, "");
+static_assert(
+    std::is_same<
+        MakeIndexPack<unsigned, 4000>,
+        Sort_t<Reverse_t<MakeIndexPack<unsigned, 4000>>>
+    >::value,
+    ""
+);
+
+#include "meta/PackAlgorithms.h"
+
+static_assert(Contains_v<int, Pack<char, int>>, "");
+static_assert(!Contains_v<long, Pack<char, int>>, "");
+static_assert(
+    std::is_same<
+        Pack<char, int, long, short, float>,
+        Concat_t<Pack<char>, Pack<>, Pack<int, long>, Pack<short>, Pack<float>>
+    >::value,
+    ""
+);
+static_assert(std::is_same<Pack<>, Concat_t<>>::value, "");
+static_assert(
+    std::is_same<
+        Pack<int, long>,
+        Filter_t<std::is_integral, Pack<float, int, void *, long>>
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        Pack<int *, char *>, Transform_t<std::add_pointer_t, Pack<int, char>>
+    >::value,
+    ""
+);
+
+template<std::size_t I> struct Message {};
+
+static_assert(
+    std::is_same<
+        Pack<Message<3>, Message<5>>,
+        Generate_t<Message, MakeIndexPack<std::size_t, 2, 3, 2>>
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        Pack<void *, char, int>,
+        Unique_t<Pack<void *, char, void *, int, char, void *>>
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        Pack<char, char, short, int, long>,
+        SortBy_t<SizeOf, Pack<long, char, short, char, int>>
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<
+        Pack<long, int, short, char, char>,
+        SortBy_t<AlignOf, Pack<char, short, char, int, long>, true>
+    >::value,
+    ""
+);
+
+using Messages1024 = Generate_t<Message, MakeIndexPack<std::size_t, 1024>>;
+
+static_assert(
+    std::is_same<
+        Messages1024,
+        Unique_t<
+            Filter_t<std::is_empty, Concat_t<Messages1024, Pack<Message<7>>>>
+        >
+    >::value,
+    ""
+);
+static_assert(
+    std::is_same<Messages1024, SortBy_t<SizeOf, Messages1024>>::value, ""
+);
+
+#include "meta/TypeMap.h"
+
+static_assert(0 == IndexOf_v<long, long, char, int>, "");
+static_assert(2 == IndexOf_v<int, Pack<long, char, int>>, "");
+static_assert(1000 == IndexOf_v<Message<1000>, Messages1024>, "");
+
+using WireIds =
+    TypeMap<Pack<
+        Pair<Message<3>, std::integral_constant<char, 'Q'>>,
+        Pair<Message<5>, std::integral_constant<char, 'T'>>,
+        Pair<void *, int>
+    >>;
+
+static_assert('T' == WireIds::value<Message<5>>, "");
+static_assert(std::is_same<int, WireIds::At<void *>>::value, "");
+static_assert(WireIds::contains<Message<3>>, "");
+static_assert(!WireIds::contains<Message<4>>, "");
+
+#include "meta/PackUnion.h"
+
+using Venues =
+    PackUnion<
+        Pack<Message<1>, void *, Message<2>, void *>,
+        Pack<Message<2>, Message<3>>,
+        Pack<>
+    >;
+
+static_assert(
+    std::is_same<
+        Pack<Message<1>, void *, Message<2>, Message<3>>, Venues::type
+    >::value,
+    ""
+);
+static_assert(1 == Venues::remap<0>[3] && 2 == Venues::remap<0>[2], "");
+static_assert(2 == Venues::remap<1>[0] && 3 == Venues::remap<1>[1], "");
+static_assert(0 == Venues::remap<2>.size(), "");
+
+template<std::size_t I>
+struct UnifiedHandler: std::integral_constant<std::size_t, I> {};
+
+static_assert(
+    std::is_same<
+        UnifiedHandler<3>,
+        Venues::Remapped<UnifiedHandler, 1>::Internal<1>
+    >::value,
+    ""
+);
+
+#include "meta/PackIndexer.h"
+
+struct InternedMessages: Interned<Pack<Message<4>, Message<8>>> {};
+
+static_assert(
+    std::is_same<
+        Message<8> *,
+        PackIndexer<std::add_pointer_t, InternedMessages>::Internal<1>
+    >::value,
+    ""
+);
+
+#include "meta/Table.h"
+
+template<std::size_t I>
+struct BitReversed {
+    constexpr static unsigned char value =
+        ((I & 1) << 3) | ((I & 2) << 1) | ((I & 4) >> 1) | ((I & 8) >> 3);
+};
+
+static_assert(0b1000 == Table<BitReversed, 16>::values[1], "");
+
+constexpr double tickSize(std::size_t instrumentClass) {
+    return 1 == instrumentClass ? 0.25 : 0.01;
+}
+
+static_assert(0.25 == FunctionTable<tickSize, 3>::values[1], "");
+static_assert(AllConstant_v<BitReversed, 16>, "");
+static_assert(AllConstant_v<UnifiedHandler, 2>, "");
+static_assert(!AllConstant_v<Message, 2>, "");
+
+template<std::size_t I>
+struct CountedHandler: std::integral_constant<std::size_t, I> {
+    static std::size_t execute() { return I; }
+};
+
+static_assert(!AllConstant_v<CountedHandler, 2>, "");
+
+template<std::size_t I>
+struct Mutable {
+    static int value;
+};
+
+template<std::size_t I>
+struct Narrowing {
+    using type = std::conditional_t<0 == I, int, long>;
+    constexpr static type value = I ? type(1) << 40 : 0;
+};
+
+template<std::size_t I>
+struct Undefined;
+
+static_assert(!AllConstant_v<Mutable, 2>, "");
+static_assert(!AllConstant_v<Narrowing, 2>, "");
+static_assert(0 == Table<Undefined, 0>::values.size(), "");
+static_assert(!TableInstantiator<Undefined, 0, int()>::isTable, "");
+
+#include "meta/TupleVisit.h"
+
+static_assert(HomogeneousTuple_v<std::tuple<long, long, long>>, "");
+static_assert(!HomogeneousTuple_v<std::tuple<long, int>>, "");
+static_assert(!HomogeneousTuple_v<std::tuple<>>, "");
+
+struct NotConstexprConstructible {
+    NotConstexprConstructible() {}
+    long value;
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+static_assert(TabulatedTuple_v<std::tuple<long, long, long>>, "");
+#endif
+static_assert(!TabulatedTuple_v<std::tuple<long, int>>, "");
+static_assert(!TabulatedTuple_v<std::tuple<>>, "");
+static_assert(
+    !TabulatedTuple_v<
+        std::tuple<NotConstexprConstructible, NotConstexprConstructible>
+    >,
+    ""
+);
+
+#include "meta/StatefulInstantiator.h"
+
+template<std::size_t I>
+struct Counting {
+    using state_t = std::conditional_t<1 == I, char, long>;
+
+    static void execute(state_t &count) { ++count; }
+};
+
+template<>
+struct Counting<2> {
+    static void execute() {}
+};
+
+using CountingLayout = StatefulInstantiator<Counting, 4, void()>::Layout;
+
+static_assert(0 == CountingLayout::offsets[0], "");
+static_assert(8 == CountingLayout::offsets[1], "");
+static_assert(9 == CountingLayout::offsets[2], "");
+static_assert(16 == CountingLayout::offsets[3], "");
+static_assert(24 == CountingLayout::size, "");
+static_assert(CacheLineSize == CountingLayout::alignment, "");
+// a thread_local block of them is constant initialized, no guard
+static_assert(
+    std::is_trivially_destructible<
+        StatefulInstantiator<Counting, 4, void()>::States
+    >::value,
+    ""
+);
+
+#include "meta/Seqlock.h"
+
+struct ThreeWords { long values[3]; };
+
+// sequence and value share one cache line, nothing else does
+static_assert(CacheLineSize == alignof(Seqlock<ThreeWords>), "");
+static_assert(CacheLineSize == sizeof(Seqlock<ThreeWords>), "");
+
+#include "meta/Conflator.h"
+
+using IntegralConflator = Conflator<Pack<int, double, char>, std::is_integral>;
+static_assert(
+    std::is_same<Pack<int, char>, IntegralConflator::conflated_t>::value, ""
+);
+static_assert(!IntegralConflator::conflates<double>, "");
+
+#include "meta/LayoutHash.h"
+
+static_assert(
+    LayoutHash_v<Pack<int, char>> != LayoutHash_v<Pack<char, int>>, ""
+);
+static_assert(LayoutHash_v<Pack<int>> != LayoutHash_v<Pack<unsigned>>, "");
+static_assert(LayoutHash_v<Pack<int>> == LayoutHash_v<Pack<signed>>, "");
+
+struct Spread {
+    std::int64_t bid, ask;
+};
+
+template<> struct meta::LayoutFields<Spread> {
+    using type = Pack<ZOO_META_FIELD(Spread, bid), ZOO_META_FIELD(Spread, ask)>;
+};
+
+// members of the same type and size swapped, as another build would see them
+using SwappedSpread = Pack<
+    Field<std::int64_t, 8, detail::stringHash("bid")>,
+    Field<std::int64_t, 0, detail::stringHash("ask")>
+>;
+static_assert(
+    detail::FieldsHash<Spread>::hash(0) !=
+        detail::FieldsHash<Spread, SwappedSpread>::hash(0),
+    ""
+);
+
+#include "meta/AsyncLogger.h"
+
+static_assert(2 == detail::formatConversions("%d%% of %s"), "");
+static_assert(3 == detail::formatConversions("%-*.*f"), "");
+static_assert(
+    detail::formatMatches<char, short, long long, std::size_t>(
+        "%hhd %hx %lld %zu", std::make_index_sequence<4>()
+    ),
+    ""
+);
+static_assert(
+    detail::formatMatches<float, long double, const char *, int *>(
+        "%.3f %Lg %s %p", std::make_index_sequence<4>()
+    ),
+    ""
+);
+static_assert(
+    !detail::formatMatches<double>("%d", std::make_index_sequence<1>()), ""
+);
+static_assert(
+    !detail::formatMatches<int>("%lld", std::make_index_sequence<1>()), ""
+);
+static_assert(
+    !detail::formatMatches<int>("%s", std::make_index_sequence<1>()), ""
+);
+static_assert(
+    !detail::formatMatches<int *>("%n", std::make_index_sequence<1>()), ""
+);
+
+constexpr char tradeFormat[] = "trade %u at %lld\n";
+using TradeSite = LogSite<tradeFormat, unsigned, long long>;
+static_assert(std::is_trivially_copyable<TradeSite>::value, "");
+
+#include "meta/StateSnapshot.h"
+
+// the file format does not depend on padding
+static_assert(40 == sizeof(SnapshotHeader), "");
+static_assert(16 == sizeof(SnapshotSection), "");
+
+#include "meta/PluginTable.h"
+
+template<typename T>
+struct OnlyChars {};
+
+template<>
+struct OnlyChars<char> {
+    static void execute(int &, const char &) {}
+};
+
+constexpr auto &OnlyCharsTable =
+    PluginTable_v<OnlyChars, Pack<int, char>, int>;
+
+static_assert(2 == OnlyCharsTable.size, "");
+static_assert(nullptr == OnlyCharsTable.handlers[0], "");
+
+#include "meta/LoadShedder.h"
+
+template<typename T>
+struct ShedDoubles: std::integral_constant<int, 0> {};
+template<>
+struct ShedDoubles<double>: std::integral_constant<int, 1> {};
+template<>
+struct ShedDoubles<long>: std::integral_constant<int, 2> {};
+
+// the integral types are conflated when shed
+using DoubleShedder =
+    LoadShedder<Pack<int, double, long>, ShedDoubles, std::is_integral>;
+
+static_assert(3 == DoubleShedder::Levels, "");
+static_assert(Admission::Deliver == DoubleShedder::action<double>(0), "");
+static_assert(Admission::Drop == DoubleShedder::action<double>(1), "");
+static_assert(Admission::Deliver == DoubleShedder::action<long>(1), "");
+static_assert(Admission::Conflate == DoubleShedder::action<long>(2), "");
+static_assert(Admission::Deliver == DoubleShedder::action<int>(2), "");
+
+#include "meta/SupersedingShedder.h"
+
+template<typename T>
+struct LongsOrdered: std::integral_constant<
+    Supersession,
+    std::is_same<long, T>::value ? Supersession::Ordered :
+    std::is_integral<T>::value ? Supersession::Commuting : Supersession::None
+> {};
+
+// the pending values are kept by the position among the types of each kind
+using Scalars = Pack<int, double, long, char>;
+using Supersessions = detail::SupersessionTable<Scalars, LongsOrdered>;
+
+static_assert(2 == Supersessions::Commuting, "");
+static_assert(1 == Supersessions::Ordered, "");
+static_assert(1 == Supersessions::slots[3] && 0 == Supersessions::slots[2], "");
+using ScalarShedder =
+    SupersedingShedder<Scalars, ShedDoubles, LongsOrdered>;
+
+static_assert(Supersession::None == ScalarShedder::supersession(1), "");
+static_assert(Supersession::Ordered == ScalarShedder::supersession(2), "");
@@ -0,0 +1,99 @@
+/// \file conflation_burst.cpp
+/// Burst benchmark of \c QuoteConflator: a burst of top of the book quotes and
+/// trades is dispatched into the conflator, a slow consumer drains it every
+/// so many messages into its own \c Books.  Compares the work done by the
+/// consumer and its final state against consuming every message.
+
+#include "MarketData.h"
+#include "QuoteConflation.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace book;
+
+/// \brief top of the book quotes and 2% trades
+constexpr MarketMix Burst = {{ 0, 0, 0, 0, 40, 10, 40, 10, 2, 0 }, 1};
+
+struct Consumer {
+    Books books;
+    std::size_t delivered = 0;
+
+    explicit Consumer(std::size_t instruments): books(instruments) {}
+
+    void operator()(const void *message, std::size_t index) {
+        ++delivered;
+        process(books, message, index);
+    }
+};
+
+struct Stage {
+    QuoteConflator conflator;
+    Consumer &consumer;
+};
+
+template<typename Message>
+struct Conflating {
+    static void execute(Stage &stage, const void *message) {
+        auto &m = *static_cast<const Message *>(message);
+        stage.conflator.push(m.instrument, m, stage.consumer);
+    }
+};
+
+void conflate(Stage &stage, const void *message, std::size_t index) {
+    meta::Instantiator<
+        meta::PackIndexer<Conflating, MessageTypeArray>::Internal,
+        10,
+        void(Stage &, const void *)
+    >::execute(stage, message, index);
+}
+
+bool sameTops(const Books &a, const Books &b) {
+    for(std::size_t i = 0; i < a.instruments.size(); ++i) {
+        auto x = a.instruments[i].top.load(), y = b.instruments[i].top.load();
+        if(
+            x.bid != y.bid || x.ask != y.ask ||
+            x.bidQuantity != y.bidQuantity || x.askQuantity != y.askQuantity ||
+            a.instruments[i].tradedVolume != b.instruments[i].tradedVolume
+        ) { return false; }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    std::uint32_t instruments = 64;
+    auto records = marketData(count, instruments, Burst, 7);
+    using Clock = std::chrono::steady_clock;
+
+    Consumer everything(instruments);
+    auto start = Clock::now();
+    for(auto &r: records) { everything(r.bytes, r.index); }
+    std::chrono::duration<double> direct = Clock::now() - start;
+    std::printf(
+        "no conflation: %zu delivered, %.3fs\n", everything.delivered,
+        direct.count()
+    );
+
+    for(std::size_t period: { 100, 1000, 10000, 100000 }) {
+        Consumer slow(instruments);
+        Stage stage{QuoteConflator(instruments), slow};
+        start = Clock::now();
+        for(std::size_t i = 0; i < count; ++i) {
+            conflate(stage, records[i].bytes, records[i].index);
+            if(0 == (i + 1) % period) { stage.conflator.drain(slow); }
+        }
+        stage.conflator.drain(slow);
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        std::printf(
+            "drain every %6zu: %9zu delivered (%6.1fx fewer), %.3fs, "
+            "final state %s\n",
+            period, slow.delivered, double(count) / slow.delivered,
+            elapsed.count(),
+            sameTops(everything.books, slow.books) ? "equal" : "DIFFERENT"
+        );
+    }
+}
@@ -0,0 +1,224 @@
+/// \file epoch_reclamation.cpp
+/// Decoded messages that own heap memory, an instrument definition and a
+/// book snapshot, are published per instrument by a decoder thread and read
+/// by several dispatch threads.  With \c EpochDomain the readers load plain
+/// pointers while pinned and the decoder retires what it replaces; the
+/// baseline is \c std::shared_ptr with its atomic reference counts, loaded
+/// and stored with the \c std::atomic_load / \c std::atomic_store overloads.
+/// Each reader does a fixed number of reads while the decoder keeps updating.
+/// Every reader checks the messages it reads against their checksum, and the
+/// messages count their destructions to verify none leaks.
+
+#include "OrderBook.h"
+
+#include <meta/EpochReclaimer.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace book;
+
+std::atomic<std::uint64_t> destroyed{0};
+
+struct Counted {
+    Counted() = default;
+    Counted(const Counted &) = delete;
+    ~Counted() { destroyed.fetch_add(1, std::memory_order_relaxed); }
+};
+
+struct Definition: Counted {
+    std::uint32_t instrument;
+    std::string symbol;
+    std::int64_t checksum;
+
+    Definition(std::uint32_t i, std::uint64_t version):
+        instrument(i),
+        symbol("INSTRUMENT-" + std::to_string(i) + "-" +
+            std::to_string(version)),
+        checksum(std::int64_t(symbol.size()))
+    {}
+
+    bool valid() const { return std::int64_t(symbol.size()) == checksum; }
+};
+
+struct Snapshot: Counted {
+    struct Level { Price price; Quantity quantity; };
+
+    std::uint32_t instrument;
+    std::vector<Level> levels;
+    std::int64_t checksum = 0;
+
+    Snapshot(std::uint32_t i, std::uint64_t version): instrument(i) {
+        for(std::size_t l = 0; l < 4 + version % 8; ++l) {
+            levels.push_back({ Price(100000 - l), Quantity(version + l) });
+            checksum += levels.back().price + levels.back().quantity;
+        }
+    }
+
+    bool valid() const {
+        std::int64_t sum = 0;
+        for(auto &l: levels) { sum += l.price + l.quantity; }
+        return sum == checksum;
+    }
+};
+
+using Decoded = Pack<Definition, Snapshot>;
+
+constexpr std::uint32_t Instruments = 64;
+constexpr std::size_t Readers = 3, ReadBatch = 16;
+
+struct Result {
+    std::uint64_t reads = 0, invalid = 0;
+};
+
+void report(
+    const char *name, double seconds, std::uint64_t updates,
+    const Result &r, std::uint64_t created
+) {
+    std::printf(
+        "%s %6.1f M reads/s, %5.2f M updates/s, %llu invalid, "
+        "%llu of %llu destroyed\n",
+        name, r.reads / seconds / 1e6, updates / seconds / 1e6,
+        (unsigned long long)r.invalid,
+        (unsigned long long)destroyed.load(), (unsigned long long)created
+    );
+}
+
+void epochs(std::uint64_t reads) {
+    using Domain = meta::EpochDomain<Decoded>;
+    destroyed = 0;
+    std::uint64_t created = 0, updates = 0;
+    auto start = std::chrono::steady_clock::now();
+    Result total;
+    {
+        Domain domain;
+        std::atomic<Definition *> definitions[Instruments];
+        std::atomic<Snapshot *> snapshots[Instruments];
+        for(std::uint32_t i = 0; i < Instruments; ++i) {
+            definitions[i] = new Definition(i, 0);
+            snapshots[i] = new Snapshot(i, 0);
+            created += 2;
+        }
+        std::atomic<std::size_t> finished{0};
+        Result results[Readers];
+        std::vector<std::thread> readers;
+        for(std::size_t r = 0; r < Readers; ++r) {
+            readers.emplace_back([&, r] {
+                auto participant = domain.join();
+                auto &result = results[r];
+                std::uint32_t i = std::uint32_t(r);
+                while(result.reads < reads / Readers) {
+                    participant.pin();
+                    for(std::size_t n = 0; n < ReadBatch; ++n) {
+                        i = (i + 7) % Instruments;
+                        auto d = definitions[i].load();
+                        auto s = snapshots[i].load();
+                        result.invalid += !d->valid() + !s->valid();
+                        result.reads += 2;
+                    }
+                    participant.unpin();
+                }
+                ++finished;
+            });
+        }
+        {
+            auto decoder = domain.join();
+            for(; finished < Readers; ++updates) {
+                auto u = updates;
+                auto i = std::uint32_t(u % Instruments);
+                if(u % 8) {
+                    decoder.retire(snapshots[i].exchange(
+                        new Snapshot(i, u), std::memory_order_acq_rel
+                    ));
+                } else {
+                    decoder.retire(definitions[i].exchange(
+                        new Definition(i, u), std::memory_order_acq_rel
+                    ));
+                }
+                ++created;
+            }
+            for(auto &t: readers) { t.join(); }
+        }
+        for(std::uint32_t i = 0; i < Instruments; ++i) {
+            delete definitions[i].load();
+            delete snapshots[i].load();
+        }
+        for(auto &r: results) {
+            total.reads += r.reads;
+            total.invalid += r.invalid;
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    report("EpochDomain:       ", elapsed.count(), updates, total, created);
+}
+
+void sharedPointers(std::uint64_t reads) {
+    destroyed = 0;
+    std::uint64_t created = 0, updates = 0;
+    auto start = std::chrono::steady_clock::now();
+    Result total;
+    {
+        std::shared_ptr<Definition> definitions[Instruments];
+        std::shared_ptr<Snapshot> snapshots[Instruments];
+        for(std::uint32_t i = 0; i < Instruments; ++i) {
+            definitions[i] = std::make_shared<Definition>(i, 0);
+            snapshots[i] = std::make_shared<Snapshot>(i, 0);
+            created += 2;
+        }
+        std::atomic<std::size_t> finished{0};
+        Result results[Readers];
+        std::vector<std::thread> readers;
+        for(std::size_t r = 0; r < Readers; ++r) {
+            readers.emplace_back([&, r] {
+                auto &result = results[r];
+                std::uint32_t i = std::uint32_t(r);
+                while(result.reads < reads / Readers) {
+                    for(std::size_t n = 0; n < ReadBatch; ++n) {
+                        i = (i + 7) % Instruments;
+                        auto d = std::atomic_load(&definitions[i]);
+                        auto s = std::atomic_load(&snapshots[i]);
+                        result.invalid += !d->valid() + !s->valid();
+                        result.reads += 2;
+                    }
+                }
+                ++finished;
+            });
+        }
+        for(; finished < Readers; ++updates) {
+            auto u = updates;
+            auto i = std::uint32_t(u % Instruments);
+            if(u % 8) {
+                std::atomic_store(
+                    &snapshots[i], std::make_shared<Snapshot>(i, u)
+                );
+            } else {
+                std::atomic_store(
+                    &definitions[i], std::make_shared<Definition>(i, u)
+                );
+            }
+            ++created;
+        }
+        for(auto &t: readers) { t.join(); }
+        for(auto &r: results) {
+            total.reads += r.reads;
+            total.invalid += r.invalid;
+        }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    report("shared_ptr counts: ", elapsed.count(), updates, total, created);
+}
+
+int main(int argc, char **argv) {
+    std::uint64_t reads =
+        1 < argc ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    epochs(reads);
+    sharedPointers(reads);
+}
@@ -0,0 +1,162 @@
+/// \file feed_arbitration.cpp
+/// Benchmark of \c FeedArbiter: two producer threads offer the A and B copies
+/// of a sequenced stream of \c OrderBook.h messages, each feed losing some of
+/// them, while the consumer dispatches the arbitrated stream through
+/// \c process.  The baseline is a mutex protected \c std::map of pending
+/// messages.
+
+#include "MarketData.h"
+
+#include <meta/FeedArbiter.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace book;
+
+/// \brief outright depth quotes on both sides, trades and upticks evenly
+constexpr MarketMix Feed = {{ 1, 0, 1, 0, 0, 0, 0, 0, 1, 1 }, 8};
+
+/// \brief The sequences each feed loses: 1% independently, 0.01% both
+std::vector<bool> losses(std::size_t count, unsigned seed) {
+    std::mt19937_64 random(seed), both(99);
+    std::vector<bool> rv(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        rv[i] = 0 == random() % 100 || 0 == both() % 10000;
+    }
+    return rv;
+}
+
+struct MapArbiter {
+    std::mutex mutex;
+    std::map<std::uint64_t, const Record *> pending;
+    std::uint64_t head = 0, seen[2] = {}, gaps = 0;
+
+    void offer(std::size_t feed, std::uint64_t sequence, const Record &r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(head <= sequence) { pending.emplace(sequence, &r); }
+        seen[feed] = sequence + 1;
+    }
+
+    template<typename Sink>
+    std::size_t poll(Sink &&sink, std::size_t limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t consumed = 0;
+        for(; consumed < limit; ++consumed, ++head) {
+            auto first = pending.begin();
+            if(pending.end() != first && head == first->first) {
+                sink(*first->second);
+                pending.erase(first);
+            } else if(head < seen[0] && head < seen[1]) {
+                ++gaps;
+            } else {
+                break;
+            }
+        }
+        return consumed;
+    }
+};
+
+using Arbiter = meta::FeedArbiter<4096, sizeof(Record::bytes)>;
+
+template<typename Offer, typename Poll>
+double run(
+    const std::vector<Record> &records, const std::vector<bool> (&lost)[2],
+    Offer offer, Poll poll
+) {
+    using Clock = std::chrono::steady_clock;
+    auto count = records.size();
+    auto start = Clock::now();
+    std::thread producers[2];
+    for(std::size_t feed = 0; feed < 2; ++feed) {
+        producers[feed] = std::thread([&, feed] {
+            for(std::size_t i = 0; i < count; ++i) {
+                if(!lost[feed][i]) { offer(feed, i, records[i]); }
+            }
+            offer(feed, count, records[0]); // end marker
+        });
+    }
+    for(std::size_t consumed = 0; consumed < count; ) {
+        auto polled = poll(count - consumed);
+        if(!polled) { std::this_thread::yield(); }
+        consumed += polled;
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    for(auto &p: producers) { p.join(); }
+    return elapsed.count();
+}
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    std::uint32_t instruments = 64;
+    auto records = marketData(count, instruments, Feed, 3);
+    const std::vector<bool> lost[2] = { losses(count, 1), losses(count, 2) };
+    std::size_t bothLost = 0;
+    for(std::size_t i = 0; i < count; ++i) {
+        bothLost += lost[0][i] && lost[1][i];
+    }
+    std::printf(
+        "%zu sequences, %zu lost by both feeds, %u hardware threads\n",
+        count, bothLost, std::thread::hardware_concurrency()
+    );
+
+    Books arbitrated(instruments);
+    auto arbiter = std::make_unique<Arbiter>();
+    std::size_t gaps = 0;
+    auto seconds = run(
+        records, lost,
+        [&](std::size_t feed, std::uint64_t sequence, const Record &r) {
+            arbiter->offer(feed, sequence, r.index, r.bytes, sizeof(r.bytes));
+        },
+        [&](std::size_t limit) {
+            return arbiter->poll(
+                [&](const void *m, std::size_t index) {
+                    process(arbitrated, m, index);
+                },
+                [&](std::uint64_t) { ++gaps; },
+                limit
+            );
+        }
+    );
+    std::printf(
+        "bitmap window: %.3fs, %.1f M sequences/s, %zu gaps\n",
+        seconds, count / seconds / 1e6, gaps
+    );
+
+    Books baseline(instruments);
+    MapArbiter map;
+    seconds = run(
+        records, lost,
+        [&](std::size_t feed, std::uint64_t sequence, const Record &r) {
+            map.offer(feed, sequence, r);
+        },
+        [&](std::size_t limit) {
+            return map.poll(
+                [&](const Record &r) { process(baseline, r.bytes, r.index); },
+                limit
+            );
+        }
+    );
+    std::printf(
+        "mutex + map:   %.3fs, %.1f M sequences/s, %llu gaps\n",
+        seconds, count / seconds / 1e6, (unsigned long long)map.gaps
+    );
+
+    auto same = true;
+    for(std::size_t i = 0; i < instruments; ++i) {
+        auto &a = arbitrated.instruments[i], &b = baseline.instruments[i];
+        same = same && a.tradedVolume == b.tradedVolume &&
+            a.upticks == b.upticks &&
+            a.bids.bestPrice() == b.bids.bestPrice();
+    }
+    std::printf("same books: %s\n", same ? "yes" : "NO");
+}
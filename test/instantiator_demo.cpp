@@ -66,3 +66,31 @@ void jumpTable(void *data, int index) {
     >::execute(data, index);
 }
 
+
+#include <meta/PackUnion.h>
+
+struct Imbalance;
+
+using OtherVenueMessageTypeArray =
+    Pack<
+        Trade,
+        Imbalance,
+        Quote<true, BID, OUTRIGHT>,
+        Quote<true, ASK, OUTRIGHT>
+    >;
+
+using AllVenues = PackUnion<MessageTypeArray, OtherVenueMessageTypeArray>;
+
+template<std::size_t Index>
+using UnifiedProcessor =
+    PackIndexer<ExchangeMessageProcessor, AllVenues::type>::Internal<Index>;
+
+/// \note the entries point to the same handlers the dispatch of the unified
+/// space would use
+void otherVenueJumpTable(void *data, int index) {
+    Instantiator<
+        AllVenues::Remapped<UnifiedProcessor, 1>::Internal,
+        4,
+        void(void *)
+    >::execute(data, index);
+}
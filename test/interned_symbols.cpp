@@ -0,0 +1,63 @@
+/// \file interned_symbols.cpp
+/// Symbols of an \c Instantiator over a pack of \c COUNT types, spelled out
+/// or, with \c INTERNED defined to 1, through an \c Interned tag.  Compiled
+/// once per \c UNIT from 0 to 3, each dispatching from its own function; unit
+/// 0 has \c main.  See interned_symbols.sh
+
+#include <meta/PackIndexer.h>
+#include <meta/Instantiator.h>
+#include <meta/PackAlgorithms.h>
+
+#include <cstdio>
+
+#ifndef COUNT
+#define COUNT 500
+#endif
+
+#ifndef INTERNED
+#define INTERNED 0
+#endif
+
+template<std::size_t I>
+struct Message {
+    unsigned value;
+};
+
+using Messages =
+    meta::Generate_t<Message, meta::MakeIndexPack<std::size_t, COUNT>>;
+
+#if INTERNED
+struct MessageSpace: meta::Interned<Messages> {};
+#else
+using MessageSpace = Messages;
+#endif
+
+template<typename M>
+struct Handler {
+    static unsigned execute(const void *m) {
+        return static_cast<const M *>(m)->value * unsigned(sizeof(M));
+    }
+};
+
+template<int Unit>
+unsigned dispatch(const void *m, std::size_t index);
+
+template<>
+unsigned dispatch<UNIT>(const void *m, std::size_t index) {
+    return meta::Instantiator<
+        meta::PackIndexer<Handler, MessageSpace>::Internal,
+        COUNT,
+        unsigned(const void *)
+    >::execute(m, index) + UNIT;
+}
+
+#if 0 == UNIT
+int main(int argc, char **) {
+    Message<0> m = { unsigned(argc) };
+    std::printf(
+        "%u\n",
+        dispatch<0>(&m, 7) + dispatch<1>(&m, 8) + dispatch<2>(&m, 9) +
+            dispatch<3>(&m, 10)
+    );
+}
+#endif
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Symbol table sizes and link time of interned_symbols.cpp, four units with
+# the pack spelled out against four with an Interned tag.  From the
+# repository root: test/interned_symbols.sh [count]
+set -e
+CXX=${CXX:-g++}
+count=${1:-500}
+directory=$(mktemp -d)
+trap 'rm -rf "$directory"' EXIT
+for interned in 0 1; do
+    label=spelled
+    [ 1 = $interned ] && label=interned
+    for unit in 0 1 2 3; do
+        $CXX -std=c++17 -O2 -g -Iinc -DCOUNT=$count -DINTERNED=$interned \
+            -DUNIT=$unit -c test/interned_symbols.cpp \
+            -o "$directory/unit$unit.o"
+    done
+    start=$(date +%s%N)
+    $CXX "$directory"/unit*.o -o "$directory/program"
+    end=$(date +%s%N)
+    longest=$(nm "$directory/program" | awk '
+        length($3) > longest { longest = length($3) }
+        END { print longest }
+    ')
+    strtab=$(readelf -SW "$directory/program" |
+        awk '$2 == ".strtab" { print $6 }')
+    debug=$(readelf -SW "$directory/program" |
+        awk '$2 == ".debug_str" { print $6 }')
+    printf '%-8s: longest symbol %s, .strtab %d KB, .debug_str %d KB, ' \
+        $label $longest $((0x$strtab / 1024)) $((0x$debug / 1024))
+    printf 'executable %d KB, link %d ms\n' \
+        $(( $(wc -c < "$directory/program") / 1024 )) \
+        $(( (end - start) / 1000000 ))
+done
@@ -0,0 +1,157 @@
+/// \file kway_merge.cpp
+/// Benchmark of \c LoserTree merging per channel streams of \c OrderBook.h
+/// messages by timestamp into the \c process dispatch, at 8, 32 and 128
+/// inputs.  The baseline is a \c std::priority_queue of \c std::variant of
+/// the message types, visited into the same handlers.
+
+#include "MarketData.h"
+
+#include <meta/LoserTree.h>
+#include <meta/TypeAtIndex.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <variant>
+#include <vector>
+
+using namespace book;
+
+template<typename> struct VariantOf;
+
+template<typename... Ts>
+struct VariantOf<Pack<Ts...>> {
+    using type = std::variant<Ts...>;
+};
+
+using Message = VariantOf<MessageTypeArray>::type;
+
+template<std::size_t... Is>
+Message toVariant(const Record &r, meta::IndexPack<std::size_t, Is...>) {
+    Message rv;
+    (
+        (
+            Is == r.index ?
+                void(rv = *reinterpret_cast<
+                    const meta::TypeAtIndex_t<Is, MessageTypeArray> *
+                >(r.bytes)) :
+                void()
+        ),
+        ...
+    );
+    return rv;
+}
+
+/// \brief A channel: an increasing series of timestamps with random messages
+struct Channel {
+    std::vector<std::uint64_t> timestamps;
+    std::vector<Record> records;
+    std::size_t position = 0;
+
+    std::size_t fill(meta::MergeEntry *destination, std::size_t capacity) {
+        std::size_t n = 0;
+        for(; n < capacity && position < records.size(); ++n, ++position) {
+            auto &r = records[position];
+            destination[n] = { timestamps[position], r.index, r.bytes };
+        }
+        return n;
+    }
+};
+
+/// \brief a depth quote, a top quote, a trade and an uptick evenly
+constexpr MarketMix Channels = {{ 1, 0, 0, 0, 0, 0, 1, 0, 1, 1 }, 8};
+
+std::vector<Channel> channels(std::size_t k, std::size_t total) {
+    std::mt19937_64 random(k);
+    std::vector<Channel> rv(k);
+    for(std::size_t c = 0; c < k; ++c) {
+        rv[c].records = marketData(total / k, 64, Channels, k * 1000 + c);
+        std::uint64_t t = 0;
+        for(std::size_t i = 0; i < rv[c].records.size(); ++i) {
+            t += 1 + random() % 100;
+            rv[c].timestamps.push_back(t);
+        }
+    }
+    return rv;
+}
+
+/// \brief order sensitive hash of the delivered messages
+void mix(std::uint64_t &hash, const void *message, std::size_t index) {
+    std::uint32_t instrument; // the first member of every message
+    std::memcpy(&instrument, message, sizeof(instrument));
+    hash = (hash ^ (instrument * 16 + index)) * 1099511628211ull;
+}
+
+struct Queued {
+    std::uint64_t timestamp;
+    std::size_t channel;
+    Message message;
+
+    bool operator<(const Queued &other) const {
+        // std::priority_queue puts the greatest on top
+        return other.timestamp < timestamp ||
+            (other.timestamp == timestamp && other.channel < channel);
+    }
+};
+
+int main(int argc, char **argv) {
+    std::size_t total =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 8 << 20;
+    using Clock = std::chrono::steady_clock;
+    for(std::size_t k: { 8, 32, 128 }) {
+        auto inputs = channels(k, total);
+        auto count = total / k * k;
+
+        Books merged(64);
+        std::uint64_t hash = 0;
+        auto start = Clock::now();
+        meta::LoserTree<Channel> tree(inputs);
+        tree.merge([&](const void *message, std::size_t index) {
+            mix(hash, message, index);
+            process(merged, message, index);
+        });
+        std::chrono::duration<double> loser = Clock::now() - start;
+
+        for(auto &c: inputs) { c.position = 0; }
+        Books queued(64);
+        std::uint64_t baselineHash = 0;
+        start = Clock::now();
+        std::priority_queue<Queued> queue;
+        auto indices = meta::MakeIndexPack<std::size_t, 10>{};
+        for(std::size_t c = 0; c < k; ++c) {
+            auto p = inputs[c].position++;
+            queue.push({
+                inputs[c].timestamps[p], c,
+                toVariant(inputs[c].records[p], indices)
+            });
+        }
+        while(!queue.empty()) {
+            auto top = queue.top();
+            queue.pop();
+            std::visit(
+                [&](const auto &m) {
+                    mix(baselineHash, &m, top.message.index());
+                    processMarketMessage(queued, m);
+                },
+                top.message
+            );
+            auto &c = inputs[top.channel];
+            if(c.position < c.records.size()) {
+                auto p = c.position++;
+                auto m = toVariant(c.records[p], indices);
+                queue.push({ c.timestamps[p], top.channel, m });
+            }
+        }
+        std::chrono::duration<double> heap = Clock::now() - start;
+
+        std::printf(
+            "%3zu inputs: loser tree %6.1f M msgs/s, "
+            "priority_queue<variant> %6.1f M msgs/s, %s\n",
+            k, count / loser.count() / 1e6, count / heap.count() / 1e6,
+            hash == baselineHash ? "same order" : "DIFFERENT"
+        );
+    }
+}
@@ -0,0 +1,184 @@
+/// \file load_shedding.cpp
+/// Bursts against a consumer slower than the burst rate, with and without a
+/// \c QuoteShedder in front of it.  The time is simulated: messages arrive at
+/// given instants, delivering one to the consumer costs \c ServiceCost and
+/// shedding one \c ShedCost, and the backlog is the count of arrived messages
+/// not yet admitted.  Reports how late the messages are admitted, trades
+/// in particular, and compares the traded volumes, tops of the book and every
+/// level of the books at the end against delivering everything.  The real
+/// cost of \c offer is measured separately.
+
+#include "QuoteShedding.h"
+
+#include <meta/IndexOf.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace book;
+
+constexpr std::uint32_t Instruments = 64;
+constexpr std::uint64_t ServiceCost = 250, ShedCost = 10; // ns
+
+/// \brief depth quotes mostly, outright ahead of implied, 4% trades
+constexpr MarketMix Shedding = {{ 30, 5, 30, 5, 10, 2, 10, 2, 4, 2 }, 8};
+
+/// \brief a message every 500 ns, and every 20 ms a burst of 1 ms with one
+/// every 25 ns, 10 times the rate the consumer takes
+std::vector<std::uint64_t> arrivals(std::size_t count) {
+    std::vector<std::uint64_t> rv(count);
+    std::uint64_t now = 0;
+    for(auto &a: rv) {
+        now += now % 20000000 < 1000000 ? 25 : 500;
+        a = now;
+    }
+    return rv;
+}
+
+struct Run {
+    Books books{Instruments};
+    std::uint64_t now = 0, delivered = 0;
+    std::uint64_t delay = 0, maxDelay = 0, tradeDelay = 0, maxTradeDelay = 0;
+    std::uint64_t trades = 0;
+    std::size_t maxBacklog = 0;
+    std::uint64_t dropped = 0, conflated = 0;
+
+    void operator()(const void *message, std::size_t index) {
+        process(books, message, index);
+        ++delivered;
+        now += ServiceCost;
+    }
+};
+
+void simulate(
+    Run &run, const std::vector<Record> &records,
+    const std::vector<std::uint64_t> &arrivals,
+    const QuoteShedder::Thresholds &thresholds
+) {
+    QuoteShedder shedder(thresholds, Instruments);
+    constexpr auto TradeIndex = meta::IndexOf_v<Trade, MessageTypeArray>;
+    std::size_t arrived = 0;
+    for(std::size_t i = 0; i < records.size(); ++i) {
+        auto &r = records[i];
+        run.now = std::max(run.now, arrivals[i]);
+        while(arrived < records.size() && arrivals[arrived] <= run.now) {
+            ++arrived;
+        }
+        auto backlog = arrived - i;
+        run.maxBacklog = std::max(run.maxBacklog, backlog);
+        shedder.backlog(backlog, run);
+        auto delay = run.now - arrivals[i];
+        run.delay += delay;
+        run.maxDelay = std::max(run.maxDelay, delay);
+        if(TradeIndex == r.index) {
+            ++run.trades;
+            run.tradeDelay += delay;
+            run.maxTradeDelay = std::max(run.maxTradeDelay, delay);
+        }
+        if(meta::Admission::Deliver != shedder.offer(r, run)) {
+            run.now += ShedCost;
+        }
+    }
+    shedder.drain(run);
+    run.dropped = shedder.count(meta::Admission::Drop);
+    run.conflated = shedder.count(meta::Admission::Conflate);
+}
+
+struct Comparison {
+    std::uint32_t volumes = 0, tops = 0, levels = 0;
+};
+
+/// \brief the levels around the mid the market data starts from, as wide as
+/// a \c Ladder
+template<QuoteSide S>
+bool sameLevels(const Side<S> &a, const Side<S> &b) {
+    for(auto lp: { OUTRIGHT, IMPLIED }) {
+        for(auto p = Price(100000 - 2048); p < Price(100000 + 2048); ++p) {
+            if(a.depth[lp].at(p) != b.depth[lp].at(p)) { return false; }
+        }
+    }
+    return true;
+}
+
+Comparison compare(const Books &a, const Books &b) {
+    Comparison rv;
+    for(std::size_t i = 0; i < Instruments; ++i) {
+        auto &x = a.instruments[i], &y = b.instruments[i];
+        rv.volumes +=
+            x.tradedVolume == y.tradedVolume && x.lastTrade == y.lastTrade &&
+            x.upticks == y.upticks;
+        auto s = x.top.load(), t = y.top.load();
+        rv.tops +=
+            s.bid == t.bid && s.ask == t.ask &&
+            s.bidQuantity == t.bidQuantity && s.askQuantity == t.askQuantity;
+        rv.levels +=
+            sameLevels(x.bids, y.bids) && sameLevels(x.asks, y.asks);
+    }
+    return rv;
+}
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+    auto records = marketData(count, Instruments, Shedding, 11);
+    auto instants = arrivals(count);
+    constexpr auto Never = std::numeric_limits<std::size_t>::max();
+
+    std::printf(
+        "%zu messages over %.3f s, %llu ns to deliver, %llu ns to shed\n",
+        count, instants.back() * 1e-9,
+        (unsigned long long)ServiceCost, (unsigned long long)ShedCost
+    );
+    Run everything;
+    QuoteShedder::Thresholds thresholdSets[] = {
+        { Never, Never }, { 16384, 65536 }, { 4096, 16384 }, { 1024, 4096 }
+    };
+    for(auto &thresholds: thresholdSets) {
+        Run run;
+        auto &r = Never == thresholds[0] ? everything : run;
+        simulate(r, records, instants, thresholds);
+        auto same = compare(everything.books, r.books);
+        if(Never == thresholds[0]) {
+            std::printf("no shedding:          ");
+        } else {
+            std::printf(
+                "shed at %5zu, %5zu: ", thresholds[0], thresholds[1]
+            );
+        }
+        std::printf(
+            "%8llu delivered, %8llu dropped, %7llu conflated, "
+            "backlog <= %7zu, delay mean %9.1f us max %9.1f us, "
+            "trades mean %9.1f us max %9.1f us, done %.3f s after the last, "
+            "volumes equal %u/%u, tops equal %u/%u, levels equal %u/%u\n",
+            (unsigned long long)r.delivered, (unsigned long long)r.dropped,
+            (unsigned long long)r.conflated, r.maxBacklog,
+            r.delay * 1e-3 / count, r.maxDelay * 1e-3,
+            r.tradeDelay * 1e-3 / r.trades, r.maxTradeDelay * 1e-3,
+            (r.now - instants.back()) * 1e-9,
+            same.volumes, Instruments, same.tops, Instruments,
+            same.levels, Instruments
+        );
+    }
+
+    // the real cost of the admission, every type seen at every level
+    using Clock = std::chrono::steady_clock;
+    QuoteShedder shedder({ 1, 2 }, Instruments);
+    std::uint64_t delivered = 0;
+    auto sink = [&](const void *, std::size_t) { ++delivered; };
+    auto start = Clock::now();
+    for(std::size_t i = 0; i < count; ++i) {
+        if(0 == i % 64) { shedder.backlog(i / 64 % 3, sink); }
+        auto &r = records[i];
+        shedder.offer(r, sink);
+    }
+    shedder.drain(sink);
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    std::printf(
+        "offer: %.1f ns/message, %llu delivered\n", elapsed.count() / count,
+        (unsigned long long)delivered
+    );
+}
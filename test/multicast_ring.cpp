@@ -0,0 +1,226 @@
+/// \file multicast_ring.cpp
+/// Throughput of \c MulticastRing feeding the \c OrderBook.h messages to three
+/// consumer threads, each with its own \c Instantiator handler set: the book
+/// builder, the risk that must run after the book builder, and an independent
+/// recorder.  The baseline copies every message into one \c SpscRing per
+/// consumer, without the dependency.
+
+#include "OrderBook.h"
+
+#include <meta/MulticastRing.h>
+#include <meta/SpscRing.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace book;
+
+struct Risk {
+    std::int64_t notional = 0;
+    std::uint64_t early = 0; ///< messages seen before the book builder did
+};
+
+template<typename Message>
+struct RiskHandler {
+    static void execute(Risk &, const void *) {}
+};
+
+template<>
+struct RiskHandler<Trade> {
+    static void execute(Risk &r, const void *message) {
+        auto &t = *static_cast<const Trade *>(message);
+        r.notional += t.quantity * t.price;
+    }
+};
+
+void risk(Risk &r, const void *message, std::size_t index) {
+    meta::Instantiator<
+        meta::PackIndexer<RiskHandler, MessageTypeArray>::Internal,
+        10,
+        void(Risk &, const void *)
+    >::execute(r, message, index);
+}
+
+struct Recorder {
+    std::uint64_t bytes = 0;
+};
+
+template<typename Message>
+struct RecordHandler {
+    static void execute(Recorder &r, const void *) {
+        r.bytes += sizeof(Message);
+    }
+};
+
+void record(Recorder &r, const void *message, std::size_t index) {
+    meta::Instantiator<
+        meta::PackIndexer<RecordHandler, MessageTypeArray>::Internal,
+        10,
+        void(Recorder &, const void *)
+    >::execute(r, message, index);
+}
+
+/// \brief the i-th message of the feed, to the given writer
+template<typename Write>
+void generate(std::size_t i, Write &&write) {
+    auto instrument = std::uint32_t(i % 64);
+    auto price = Price(100000 + i % 8);
+    switch(i % 4) {
+        case 0:
+            write(Quote<false, BID, OUTRIGHT>{instrument, 10, price});
+            break;
+        case 1:
+            write(Quote<false, ASK, OUTRIGHT>{instrument, 10, price + 8});
+            break;
+        case 2: write(Trade{instrument, 1, price}); break;
+        default: write(Uptick{instrument});
+    }
+}
+
+struct Results {
+    std::int64_t volume, notional;
+    std::uint64_t bytes, early;
+
+    void print(const char *name, std::size_t count, double seconds) const {
+        std::printf(
+            "%s %6.1f M msgs/s, volume %lld, notional %lld, "
+            "recorded %llu bytes, %llu early\n",
+            name, count / seconds / 1e6, (long long)volume,
+            (long long)notional, (unsigned long long)bytes,
+            (unsigned long long)early
+        );
+    }
+};
+
+std::int64_t volume(const Books &books) {
+    std::int64_t rv = 0;
+    for(auto &i: books.instruments) { rv += i.tradedVolume; }
+    return rv;
+}
+
+constexpr std::size_t Batch = 64;
+
+Results multicast(std::size_t count) {
+    enum { BookBuilder, RiskCheck, Recording };
+    using Ring = meta::MulticastRing<MessageTypeArray, 1 << 14>;
+    Ring ring({ {}, { BookBuilder }, {} });
+    Books books(64);
+    Risk r;
+    Recorder recorder;
+    auto consume = [&](std::size_t consumer, auto &&sink) {
+        while(ring.consumed(consumer) < count) {
+            if(!ring.poll(consumer, sink, Batch)) {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::thread builder([&] {
+        consume(BookBuilder, [&](const void *message, std::size_t index) {
+            process(books, message, index);
+        });
+    });
+    std::thread checker([&] {
+        std::uint64_t sequence = 0;
+        consume(RiskCheck, [&](const void *message, std::size_t index) {
+            r.early += ring.consumed(BookBuilder) <= sequence++;
+            risk(r, message, index);
+        });
+    });
+    std::thread recorderThread([&] {
+        consume(Recording, [&](const void *message, std::size_t index) {
+            record(recorder, message, index);
+        });
+    });
+    for(std::size_t i = 0; i < count; i += Batch) {
+        auto n = std::min(Batch, count - i);
+        while(!ring.tryClaim(n)) { std::this_thread::yield(); }
+        for(std::size_t j = i; j < i + n; ++j) {
+            generate(j, [&](const auto &m) { ring.write(m); });
+        }
+        ring.publish();
+    }
+    builder.join();
+    checker.join();
+    recorderThread.join();
+    return { volume(books), r.notional, recorder.bytes, r.early };
+}
+
+Results copies(std::size_t count) {
+    using Ring = meta::SpscRing<MessageTypeArray>;
+    Ring rings[3] = { Ring(1 << 20), Ring(1 << 20), Ring(1 << 20) };
+    Books books(64);
+    Risk r;
+    Recorder recorder;
+    auto consume = [&](Ring &ring, auto &&sink) {
+        auto c = ring.consumer();
+        for(std::size_t consumed = 0; consumed < count; ) {
+            auto n = c.poll(sink, Batch);
+            if(!n) { std::this_thread::yield(); }
+            consumed += n;
+        }
+    };
+    std::thread builder([&] {
+        consume(rings[0], [&](const void *message, std::size_t index) {
+            process(books, message, index);
+        });
+    });
+    std::thread checker([&] {
+        consume(rings[1], [&](const void *message, std::size_t index) {
+            risk(r, message, index);
+        });
+    });
+    std::thread recorderThread([&] {
+        consume(rings[2], [&](const void *message, std::size_t index) {
+            record(recorder, message, index);
+        });
+    });
+    meta::RingProducer<MessageTypeArray> producers[3] = {
+        rings[0].producer(), rings[1].producer(), rings[2].producer()
+    };
+    for(std::size_t i = 0; i < count; i += Batch) {
+        auto n = std::min(Batch, count - i);
+        for(std::size_t j = i; j < i + n; ++j) {
+            generate(j, [&](const auto &m) {
+                for(auto &p: producers) {
+                    while(!p.push(m)) {
+                        p.commit();
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for(auto &p: producers) { p.commit(); }
+    }
+    builder.join();
+    checker.join();
+    recorderThread.join();
+    return { volume(books), r.notional, recorder.bytes, 0 };
+}
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now();
+    auto m = multicast(count);
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    m.print("multicast ring:   ", count, elapsed.count());
+
+    start = Clock::now();
+    auto c = copies(count);
+    elapsed = Clock::now() - start;
+    c.print("SpscRing per reader:", count, elapsed.count());
+
+    meta::MulticastRing<MessageTypeArray, 16> small(
+        std::vector<std::vector<std::size_t>>(1)
+    );
+    std::printf(
+        "claims beyond the capacity: %s\n",
+        small.tryClaim(17) || small.tryClaim(~std::size_t(0)) ?
+            "ACCEPTED" : "rejected"
+    );
+}
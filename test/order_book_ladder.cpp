@@ -0,0 +1,38 @@
+/// \file order_book_ladder.cpp
+/// The \c Ladder of \c OrderBook.h with levels beyond its width: the best
+/// level must survive depth updates far on the passive side, and a more
+/// aggressive level must become the best
+
+#include "OrderBook.h"
+
+#include <cstdio>
+
+using namespace book;
+
+int main() {
+    auto failures = 0;
+
+    Ladder<BID> bids;
+    bids.update(100000, 10);
+    bids.update(95000, 3); // further than the width, not kept
+    failures += 100000 != bids.bestPrice() || 10 != bids.at(100000);
+    bids.update(99000, 4); // deep but within the width once recentered
+    failures += 100000 != bids.bestPrice() || 4 != bids.at(99000);
+    bids.update(104000, 2); // more aggressive than the window
+    failures += 104000 != bids.bestPrice() || 2 != bids.bestQuantity();
+    failures += 10 != bids.at(100000);
+    bids.update(120000, 1); // the new best, too far to keep the others
+    failures += 120000 != bids.bestPrice() || 1 != bids.bestQuantity();
+
+    Ladder<ASK> asks;
+    asks.update(100, 7);
+    asks.update(4196, 1);
+    failures += 100 != asks.bestPrice() || 7 != asks.at(100);
+    asks.update(-3000, 5);
+    failures += -3000 != asks.bestPrice() || 5 != asks.bestQuantity();
+    asks.update(-3000, 0);
+    failures += 100 != asks.bestPrice();
+
+    std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+/// \file order_book_replay.cpp
+/// Replay benchmark of \c OrderBook.h: synthetic quotes and trades over
+/// several instruments, dispatched through the \c Instantiator jump table.
+/// Reports updates per second and latency percentiles per message.
+
+#include "MarketData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace book;
+
+/// \brief depth quotes mostly, outright ahead of implied, 2% trades
+constexpr MarketMix Replay = {{ 30, 6, 30, 5, 10, 3, 10, 3, 2, 1 }, 10};
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    std::uint32_t instruments = 64;
+    auto records = marketData(count, instruments, Replay, 42);
+
+    using Clock = std::chrono::steady_clock;
+    {
+        Books books(instruments);
+        auto start = Clock::now();
+        for(auto &r: records) { process(books, r.bytes, r.index); }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        std::printf(
+            "%zu messages in %.3fs, %.1f M updates/s\n",
+            count, elapsed.count(), count / elapsed.count() / 1e6
+        );
+    }
+
+    // timing each message adds the cost of reading the clock, subtracted
+    // below as the median of timing nothing
+    Books books(instruments);
+    std::vector<std::int64_t> latencies(count), overhead(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        auto start = Clock::now();
+        process(books, records[i].bytes, records[i].index);
+        latencies[i] = (Clock::now() - start).count();
+    }
+    for(std::size_t i = 0; i < count; ++i) {
+        auto start = Clock::now();
+        overhead[i] = (Clock::now() - start).count();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::sort(overhead.begin(), overhead.end());
+    auto clock = overhead[count / 2];
+    auto percentile = [&](double p) {
+        return latencies[std::size_t(p * (count - 1))] - clock;
+    };
+    std::printf(
+        "latency ns, clock overhead %lld subtracted: "
+        "p50 %lld p90 %lld p99 %lld p99.9 %lld max %lld\n",
+        (long long)clock, (long long)percentile(0.5),
+        (long long)percentile(0.9), (long long)percentile(0.99),
+        (long long)percentile(0.999), (long long)percentile(1)
+    );
+    auto &b = books.instruments[0];
+    std::printf(
+        "instrument 0: bid %lld ask %lld volume %d\n",
+        (long long)b.bids.bestPrice(), (long long)b.asks.bestPrice(),
+        b.tradedVolume
+    );
+}
@@ -0,0 +1,202 @@
+/// \file outbound_writer.cpp
+/// Encoding of order entry messages with \c OutboundWriter, the wire ids
+/// mapped at compile time by a \c TypeMap, against a lookup of the id by
+/// \c std::type_index and a \c write per message.  The orders come in bursts
+/// after which the writer is polled, as an order entry gateway reacting to
+/// market data.  Both write to temporary files that are compared afterwards.
+
+#include "OrderBook.h"
+
+#include <meta/OutboundWriter.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include <sys/time.h>
+#include <unistd.h>
+
+using namespace book;
+
+// without padding, whose bytes are indeterminate, to compare the outputs
+struct NewOrder {
+    std::uint64_t order;
+    Price price;
+    std::uint32_t instrument;
+    Quantity quantity;
+    std::uint32_t side, account;
+};
+
+struct CancelOrder {
+    std::uint64_t order;
+    std::uint32_t instrument, account;
+};
+
+struct ReplaceOrder {
+    std::uint64_t order, original;
+    Price price;
+    std::uint32_t instrument;
+    Quantity quantity;
+};
+
+template<char Id>
+using WireId = std::integral_constant<std::uint16_t, Id>;
+
+using OrderEntryIds =
+    meta::TypeMap<Pack<
+        meta::Pair<NewOrder, WireId<'D'>>,
+        meta::Pair<CancelOrder, WireId<'F'>>,
+        meta::Pair<ReplaceOrder, WireId<'G'>>
+    >>;
+
+constexpr std::size_t Burst = 32;
+
+/// \brief the i-th order, to \c send
+template<typename Send>
+void order(std::uint64_t i, Send &&send) {
+    auto instrument = std::uint32_t(i % 64);
+    switch(i % 4) {
+        case 0:
+        case 1:
+            send(NewOrder{
+                i, Price(100000 + i % 8), instrument, 10,
+                std::uint32_t(i % 2), 7
+            });
+            break;
+        case 2:
+            send(ReplaceOrder{i, i - 2, Price(100000 + i % 8), instrument, 5});
+            break;
+        default: send(CancelOrder{i - 3, instrument, 7});
+    }
+}
+
+/// \brief What the gateway did before: one lookup and one write each
+struct PerMessage {
+    int fd;
+    std::unordered_map<std::type_index, std::uint16_t> ids = {
+        { typeid(NewOrder), 'D' },
+        { typeid(CancelOrder), 'F' },
+        { typeid(ReplaceOrder), 'G' }
+    };
+    std::uint64_t writes = 0;
+
+    template<typename Message>
+    void operator()(const Message &m) {
+        unsigned char frame[sizeof(meta::WireHeader) + sizeof(Message)];
+        meta::WireHeader header = {
+            std::uint16_t(sizeof(frame)), ids.at(typeid(Message))
+        };
+        std::memcpy(frame, &header, sizeof(header));
+        std::memcpy(frame + sizeof(header), &m, sizeof(m));
+        if(write(fd, frame, sizeof(frame)) != ssize_t(sizeof(frame))) {
+            std::abort();
+        }
+        ++writes;
+    }
+};
+
+std::vector<char> contents(std::FILE *file) {
+    std::vector<char> rv;
+    std::rewind(file);
+    char buffer[1 << 16];
+    for(std::size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)); ) {
+        rv.insert(rv.end(), buffer, buffer + n);
+    }
+    return rv;
+}
+
+/// \brief Flushes into a blocking pipe that a reader drains late, while a
+/// timer interrupts the writes every millisecond
+/// \return the flushes that returned without writing anything
+std::size_t interruptedFlushes() {
+    int pipeFds[2];
+    if(pipe(pipeFds)) { std::abort(); }
+    struct sigaction action = {};
+    action.sa_handler = [](int) {}; // without SA_RESTART
+    sigaction(SIGALRM, &action, nullptr);
+    sigset_t alarm;
+    sigemptyset(&alarm);
+    sigaddset(&alarm, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &alarm, nullptr);
+    std::thread reader([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        char buffer[4096];
+        while(0 < read(pipeFds[0], buffer, sizeof(buffer))) {}
+    });
+    pthread_sigmask(SIG_UNBLOCK, &alarm, nullptr);
+
+    meta::OutboundWriter<OrderEntryIds> writer(
+        pipeFds[1], { 1 << 20, std::chrono::seconds(1) }
+    );
+    for(std::uint64_t i = 0; i < 8192; ++i) {
+        order(i, [&](const auto &m) { writer.encode(m); });
+    }
+    itimerval every = { { 0, 1000 }, { 0, 1000 } }, off = {};
+    setitimer(ITIMER_REAL, &every, nullptr);
+    std::size_t rv = 0;
+    while(writer.pending()) { rv += !writer.flush(); }
+    setitimer(ITIMER_REAL, &off, nullptr);
+    close(pipeFds[1]);
+    reader.join();
+    close(pipeFds[0]);
+    return rv;
+}
+
+int main(int argc, char **argv) {
+    std::uint64_t count =
+        1 < argc ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    using Clock = std::chrono::steady_clock;
+
+    auto batched = std::tmpfile(), single = std::tmpfile();
+    if(!batched || !single) { return 1; }
+
+    meta::OutboundWriter<OrderEntryIds> writer(
+        fileno(batched), { 16 << 10, std::chrono::microseconds(20) }
+    );
+    auto start = Clock::now();
+    for(std::uint64_t i = 0; i < count; ) {
+        for(auto end = i + Burst; i < end && i < count; ++i) {
+            order(i, [&](const auto &m) {
+                if(!writer.encode(m)) { std::abort(); }
+            });
+        }
+        writer.poll();
+    }
+    writer.flush();
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    std::printf(
+        "OutboundWriter: %6.1f ns/message, %llu writev\n",
+        elapsed.count() / count, (unsigned long long)writer.writes()
+    );
+
+    PerMessage perMessage{fileno(single)};
+    start = Clock::now();
+    for(std::uint64_t i = 0; i < count; ++i) { order(i, perMessage); }
+    elapsed = Clock::now() - start;
+    std::printf(
+        "lookup + write: %6.1f ns/message, %llu write\n",
+        elapsed.count() / count, (unsigned long long)perMessage.writes
+    );
+
+    auto same = contents(batched) == contents(single);
+    std::printf("same bytes: %s\n", same ? "yes" : "NO");
+    auto stalls = interruptedFlushes();
+    std::printf("interrupted flushes without progress: %zu\n", stalls);
+
+    // one writev takes the blocks
+    auto rejected = false;
+    try {
+        meta::OutboundWriter<OrderEntryIds> tooMany(
+            fileno(single), {}, 64, std::size_t(IOV_MAX) + 1
+        );
+    } catch(std::invalid_argument &) { rejected = true; }
+    std::printf(
+        "blocks beyond IOV_MAX: %s\n", rejected ? "rejected" : "NOT REJECTED"
+    );
+    return same && !stalls && rejected ? 0 : 1;
+}
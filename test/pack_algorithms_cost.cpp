@@ -0,0 +1,47 @@
+/// \file pack_algorithms_cost.cpp
+/// Compile time cost of the \c Pack algorithms on a pack of \c COUNT types,
+/// every other one repeated, of varied sizes.  \c ALGORITHM selects what is
+/// applied, \c None measures generating the pack alone; see compile_cost.sh
+
+#include <meta/PackAlgorithms.h>
+
+#ifndef COUNT
+#define COUNT 1024
+#endif
+
+#ifndef ALGORITHM
+#define ALGORITHM None
+#endif
+
+template<std::size_t I>
+struct Element {
+    char bytes[I % 61 + 1];
+};
+
+template<std::size_t I>
+using Repeated = Element<I / 2 * 2>;
+
+template<typename T>
+using Small = std::integral_constant<bool, sizeof(T) < 32>;
+
+using Elements =
+    meta::Generate_t<Repeated, meta::MakeIndexPack<std::size_t, COUNT>>;
+
+template<typename P>
+using None = P;
+
+template<typename P>
+using Filter = meta::Filter_t<Small, P>;
+
+template<typename P>
+using Unique = meta::Unique_t<P>;
+
+template<typename P>
+using SortBy = meta::SortBy_t<meta::SizeOf, P>;
+
+template<typename P>
+using Concat = meta::Concat_t<P, P, P, P>;
+
+using Result = ALGORITHM<Elements>;
+
+static_assert(sizeof(Result), "");
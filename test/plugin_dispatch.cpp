@@ -0,0 +1,103 @@
+/// \file plugin_dispatch.cpp
+/// Dispatch of the \c OrderBook.h messages through a \c DispatchTable with
+/// the handlers of \c plugin_strategy.cpp, loaded from the shared object
+/// named by the first argument, installed over the built in ones, against a
+/// registry of \c std::function by index holding the same handlers.  The
+/// built in \c Instantiator dispatch, without the plugin, is the reference
+/// of the cost.
+
+#include "MarketData.h"
+#include "MessageLayout.h"
+
+#include <meta/PluginTable.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+using namespace book;
+
+template<typename Message>
+struct Builtin {
+    static void execute(Books &books, const Message &m) {
+        processMarketMessage(books, m);
+    }
+};
+
+using Table = meta::DispatchTable<MessageTypeArray, Books>;
+
+/// \brief outright quotes, twice as many of depth, trades and upticks
+constexpr MarketMix Messages = {{ 2, 0, 2, 0, 1, 0, 1, 0, 1, 1 }, 8};
+
+std::int64_t checksum(const Books &books) {
+    std::int64_t rv = 0;
+    for(auto &i: books.instruments) { rv += i.tradedVolume * 31 + i.upticks; }
+    return rv;
+}
+
+template<typename Dispatch>
+void run(const char *name, const std::vector<Record> &records, Dispatch &&d) {
+    Books books(64);
+    auto start = std::chrono::steady_clock::now();
+    for(auto &r: records) { d(books, r.bytes, r.index); }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf(
+        "%s %5.1f ns/message, checksum %lld\n",
+        name, elapsed.count() / records.size(), (long long)checksum(books)
+    );
+}
+
+int main(int argc, char **argv) {
+    auto path = 1 < argc ? argv[1] : "./plugin_strategy.so";
+    std::size_t count =
+        2 < argc ? std::strtoul(argv[2], nullptr, 10) : 20000000;
+    auto records = marketData(count, 64, Messages, 7);
+
+    meta::Plugin plugin(path);
+    Table table(meta::PluginTable_v<Builtin, MessageTypeArray, Books>);
+    table.install(plugin.table());
+
+    std::unordered_map<std::size_t, std::function<void(Books &, const void *)>>
+        registry;
+    auto &builtins = meta::PluginTable_v<Builtin, MessageTypeArray, Books>;
+    for(std::size_t i = 0; i < 10; ++i) {
+        auto handler = plugin.table().handlers[i] ?
+            plugin.table().handlers[i] : builtins.handlers[i];
+        registry[i] = [handler](Books &books, const void *message) {
+            handler(&books, message);
+        };
+    }
+
+    run("built in Instantiator:", records, process);
+    run("plugin DispatchTable: ", records,
+        [&](Books &books, const void *message, std::size_t index) {
+            table.execute(books, message, index);
+        }
+    );
+    run("std::function registry:", records,
+        [&](Books &books, const void *message, std::size_t index) {
+            registry.at(index)(books, message);
+        }
+    );
+
+    table.restore();
+    run("DispatchTable restored:", records,
+        [&](Books &books, const void *message, std::size_t index) {
+            table.execute(books, message, index);
+        }
+    );
+
+    try {
+        meta::DispatchTable<Pack<Trade, Uptick>, Books> other(
+            meta::PluginTable_v<Builtin, Pack<Trade, Uptick>, Books>
+        );
+        other.install(plugin.table());
+        std::printf("mismatched plugin: NOT DETECTED\n");
+    } catch(std::runtime_error &e) {
+        std::printf("mismatched plugin: %s\n", e.what());
+    }
+}
@@ -0,0 +1,29 @@
+/// \file plugin_strategy.cpp
+/// A strategy shipped as a shared object, loaded by \c plugin_dispatch.cpp:
+/// it counts the trades at a higher price than the last one as upticks, and
+/// leaves the other messages to the built in handlers of the host.
+///
+///     g++ -std=c++17 -O2 -shared -fPIC -Iinc -o plugin_strategy.so
+///         test/plugin_strategy.cpp
+
+#include "MessageLayout.h"
+
+#include <meta/PluginTable.h>
+
+using namespace book;
+
+template<typename Message>
+struct Strategy {};
+
+template<>
+struct Strategy<Trade> {
+    static void execute(Books &books, const Trade &t) {
+        auto &instrument = books.instruments[t.instrument];
+        if(instrument.lastTrade && instrument.lastTrade < t.price) {
+            ++instrument.upticks;
+        }
+        processMarketMessage(books, t);
+    }
+};
+
+ZOO_META_EXPORT_PLUGIN(Strategy, MessageTypeArray, Books)
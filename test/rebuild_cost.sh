@@ -0,0 +1,64 @@
+#!/bin/sh
+# Serial rebuild time of many translation units, each instantiating a small
+# Instantiator dispatch.  Every way brings in the same headers, the ones
+# module/meta.cppm includes: textually in C++17 and C++20, precompiled in
+# C++20, and imported as the module.  From the repository root, or through
+# make rebuild_cost: test/rebuild_cost.sh [units]
+set -e
+CXX=${CXX:-g++}
+units=${1:-200}
+root=$(pwd)
+directory=$(mktemp -d)
+trap 'rm -rf "$directory"' EXIT
+cd "$directory"
+
+# the global module fragment and the exported headers, in the same order
+mkdir -p headers pch
+grep '^#include <' "$root/module/meta.cppm" > headers/exported.h
+
+unit() { # $1 the index, $2 how the library is brought in
+    printf '%s\n' "$2"
+    cat <<UNIT
+template<std::size_t I>
+struct Handler$1 {
+    static unsigned execute(unsigned x) { return x * unsigned(I + $1); }
+};
+
+unsigned dispatch$1(unsigned x, std::size_t index) {
+    return meta::Instantiator<Handler$1, 16, unsigned(unsigned)>::execute(
+        x, index
+    );
+}
+UNIT
+}
+
+for i in $(seq $units); do
+    unit $i '#include <exported.h>' > textual$i.cpp
+    unit $i '#include <cstddef>
+import meta;' > imported$i.cpp
+done
+
+build() { # $1 the label, $2 the prefix of the sources, the rest the flags
+    label=$1
+    prefix=$2
+    shift 2
+    start=$(date +%s%N)
+    for i in $(seq $units); do
+        $CXX "$@" -O2 -c $prefix$i.cpp -o $prefix$i.o
+    done
+    end=$(date +%s%N)
+    milliseconds=$(( (end - start) / 1000000 ))
+    printf '%-12s %d.%02ds\n' "$label" \
+        $((milliseconds / 1000)) $((milliseconds % 1000 / 10))
+}
+
+build 'C++17' textual -std=c++17 -Iheaders -I"$root/inc"
+build 'C++20' textual -std=c++20 -Iheaders -I"$root/inc"
+
+$CXX -std=c++20 -O2 -I"$root/inc" -x c++-header headers/exported.h \
+    -o pch/exported.h.gch
+build 'C++20 PCH' textual -std=c++20 -Ipch -Iheaders -I"$root/inc"
+
+$CXX -std=c++20 -fmodules-ts -O2 -I"$root/inc" -x c++ \
+    -c "$root/module/meta.cppm" -o meta.o
+build 'C++20 module' imported -std=c++20 -fmodules-ts
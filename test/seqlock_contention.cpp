@@ -0,0 +1,101 @@
+/// \file seqlock_contention.cpp
+/// Contention benchmark of the top of the book snapshots of \c OrderBook.h:
+/// one thread dispatches top of the book quotes through \c process while 1 to
+/// 16 readers copy the \c Seqlock published snapshots.  Every quote carries a
+/// quantity derived from its price, a torn copy would break that relation.
+
+#include "OrderBook.h"
+
+#include <meta/IndexOf.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace book;
+
+constexpr std::uint32_t Instruments = 8;
+
+Quantity quantityFor(Price p) { return Quantity(p % 1000 + 1); }
+
+struct ReaderCounts {
+    std::uint64_t loads = 0, retries = 0;
+    std::uint64_t torn = 0;
+};
+
+void reader(
+    const Books &books, const std::atomic<bool> &done, ReaderCounts &counts
+) {
+    std::uint64_t loads = 0, retries = 0, torn = 0;
+    for(std::uint32_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+        auto &seqlock = books.instruments[i % Instruments].top;
+        TopOfBook t;
+        while(!seqlock.tryLoad(t)) { ++retries; }
+        ++loads;
+        if(t.bidQuantity && t.bidQuantity != quantityFor(t.bid)) { ++torn; }
+        if(t.askQuantity && t.askQuantity != quantityFor(t.ask)) { ++torn; }
+    }
+    counts.loads = loads;
+    counts.retries = retries;
+    counts.torn = torn;
+}
+
+template<QuoteSide S>
+void quote(Books &books, std::uint32_t instrument, Price p) {
+    Quote<true, S, OUTRIGHT> q{instrument, quantityFor(p), p};
+    process(books, &q, meta::IndexOf_v<decltype(q), MessageTypeArray>);
+}
+
+int main(int argc, char **argv) {
+    double seconds = 1 < argc ? std::strtod(argv[1], nullptr) : 0.5;
+    using Clock = std::chrono::steady_clock;
+    std::printf(
+        "%u hardware threads, %.2fs per configuration\n",
+        std::thread::hardware_concurrency(), seconds
+    );
+    for(auto readers: { 0, 1, 2, 4, 8, 16 }) {
+        Books books(Instruments);
+        std::atomic<bool> done{false};
+        std::vector<ReaderCounts> counts(readers);
+        std::vector<std::thread> threads;
+        for(auto r = 0; r < readers; ++r) {
+            threads.emplace_back(
+                reader, std::cref(books), std::cref(done), std::ref(counts[r])
+            );
+        }
+        std::uint64_t writes = 0;
+        auto start = Clock::now();
+        auto deadline = start + std::chrono::duration<double>(seconds);
+        Price walk = 100000;
+        while(Clock::now() < deadline) {
+            for(auto i = 1024; i--; ) {
+                // oscillates in a band of 64 ticks to not recenter ladders
+                walk = 100000 + Price(writes % 64);
+                auto instrument = std::uint32_t(writes % Instruments);
+                quote<BID>(books, instrument, walk - 1);
+                quote<ASK>(books, instrument, walk + 1);
+                writes += 2;
+            }
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        done = true;
+        for(auto &t: threads) { t.join(); }
+        std::uint64_t loads = 0, retries = 0, torn = 0;
+        for(auto &c: counts) {
+            loads += c.loads;
+            retries += c.retries;
+            torn += c.torn;
+        }
+        std::printf(
+            "%2d readers: writer %6.1f M quotes/s, "
+            "readers %7.1f M loads/s, retries %5.2f%%, torn %llu\n",
+            readers, writes / elapsed.count() / 1e6,
+            loads / elapsed.count() / 1e6,
+            loads ? 100.0 * retries / (loads + retries) : 0.0,
+            (unsigned long long)torn
+        );
+    }
+}
@@ -0,0 +1,27 @@
+/// \file sharded_instantiator.cpp
+/// Dispatch through a \c ShardedInstantiator whose entries are only declared
+/// here, linked against the shard translation units, checked against an
+/// \c Instantiator over the same handlers.  See sharded_instantiator.sh
+
+#include "ShardedEmulator.h"
+
+#include <meta/Instantiator.h>
+
+#include <cstdio>
+
+int main() {
+    using Reference =
+        meta::Instantiator<Emulate, Opcodes, unsigned(unsigned)>;
+    unsigned mismatches = 0;
+    for(unsigned accumulator: { 0u, 1u, 7u, 0xDEADBEEFu }) {
+        for(std::size_t opcode = 0; opcode < Opcodes; ++opcode) {
+            mismatches +=
+                Emulator::execute(accumulator, opcode) !=
+                    Reference::execute(accumulator, opcode);
+        }
+    }
+    std::printf(
+        "%zu shards, %u mismatches\n", Emulator::shards, mismatches
+    );
+    return mismatches ? 1 : 0;
+}
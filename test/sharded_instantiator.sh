@@ -0,0 +1,18 @@
+#!/bin/sh
+# Builds sharded_instantiator.cpp with the shards of its dispatcher compiled
+# in parallel, each in its own translation unit, and runs it.  From the
+# repository root: test/sharded_instantiator.sh
+set -e
+CXX=${CXX:-g++}
+directory=$(mktemp -d)
+trap 'rm -rf "$directory"' EXIT
+flags="-std=c++17 -O2 -Wall -Wextra -Iinc"
+for shard in 0 1 2 3; do
+    $CXX $flags -DSHARD=$shard -c test/sharded_instantiator_shard.cpp \
+        -o "$directory/shard$shard.o" &
+    shards="$shards $!"
+done
+$CXX $flags -c test/sharded_instantiator.cpp -o "$directory/main.o"
+for pid in $shards; do wait $pid; done
+$CXX "$directory"/*.o -o "$directory/sharded_instantiator"
+"$directory/sharded_instantiator"
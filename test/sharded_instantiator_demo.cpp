@@ -0,0 +1,24 @@
+#include <meta/ShardedInstantiator.h>
+
+template<std::size_t Opcode>
+struct Emulate {
+    static unsigned execute(unsigned accumulator) {
+        return accumulator * (Opcode | 1) + Opcode;
+    }
+};
+
+using Emulator = meta::ShardedInstantiator<Emulate, 200, 6, unsigned(unsigned)>;
+
+unsigned emulate(unsigned accumulator, unsigned char opcode) {
+    return Emulator::execute(accumulator, opcode);
+}
+
+// Each of the lines below would be in its own translation unit
+
+#include <meta/ShardedInstantiatorShard.h>
+
+ZOO_META_INSTANTIATE_SHARD(Emulator, 6, 0)
+ZOO_META_INSTANTIATE_SHARD(Emulator, 6, 1)
+ZOO_META_INSTANTIATE_SHARD(Emulator, 6, 2)
+ZOO_META_EXTERN_SHARD(Emulator, 6, 3)
+ZOO_META_INSTANTIATE_SHARD(Emulator, 6, 3)
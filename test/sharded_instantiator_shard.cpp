@@ -0,0 +1,8 @@
+/// \file sharded_instantiator_shard.cpp
+/// The shard \c SHARD of the \c Emulator, see sharded_instantiator.sh
+
+#include "ShardedEmulator.h"
+
+#include <meta/ShardedInstantiatorShard.h>
+
+ZOO_META_INSTANTIATE_SHARD(Emulator, 6, SHARD)
@@ -0,0 +1,131 @@
+/// \file shared_ring.cpp
+/// Throughput of \c SharedRing with the consumer in a forked process that
+/// dispatches the \c OrderBook.h messages in place through \c process, against
+/// the in process \c SpscRing between two threads running the same code.
+
+#include "MessageLayout.h"
+
+#include <meta/SharedRing.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace book;
+
+using Ring = meta::SharedRing<MessageTypeArray>;
+
+template<typename M>
+void push(meta::RingProducer<MessageTypeArray> &p, const M &m) {
+    while(!p.push(m)) {
+        p.commit();
+        std::this_thread::yield();
+    }
+}
+
+void produce(meta::RingProducer<MessageTypeArray> &&p, std::size_t count) {
+    for(std::size_t i = 0; i < count; ++i) {
+        auto instrument = std::uint32_t(i % 64);
+        auto price = Price(100000 + i % 8);
+        switch(i % 4) {
+            case 0:
+                push(p, Quote<false, BID, OUTRIGHT>{instrument, 10, price});
+                break;
+            case 1:
+                push(p, Quote<false, ASK, OUTRIGHT>{instrument, 10, price + 8});
+                break;
+            case 2: push(p, Trade{instrument, 1, price}); break;
+            default: push(p, Uptick{instrument});
+        }
+        if(63 == i % 64) { p.commit(); }
+    }
+    p.commit();
+}
+
+/// \return the total traded volume, as a check
+std::int64_t
+consume(meta::RingConsumer<MessageTypeArray> &&c, std::size_t count) {
+    Books books(64);
+    for(std::size_t consumed = 0; consumed < count; ) {
+        auto n = c.poll([&](const void *message, std::size_t index) {
+            process(books, message, index);
+        });
+        if(!n) { c.wait(); }
+        consumed += n;
+    }
+    std::int64_t volume = 0;
+    for(auto &i: books.instruments) { volume += i.tradedVolume; }
+    return volume;
+}
+
+int main(int argc, char **argv) {
+    std::size_t count =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+    constexpr std::size_t Capacity = 1 << 20;
+    using Clock = std::chrono::steady_clock;
+
+    {
+        meta::SpscRing<MessageTypeArray> ring(Capacity);
+        std::int64_t volume = 0;
+        auto start = Clock::now();
+        std::thread consumer([&] { volume = consume(ring.consumer(), count); });
+        produce(ring.producer(), count);
+        consumer.join();
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        std::printf(
+            "in process SpscRing:   %6.1f M msgs/s, volume %lld\n",
+            count / elapsed.count() / 1e6, (long long)volume
+        );
+    }
+
+    auto name = "/zoo_meta_ring_" + std::to_string(getpid());
+    auto ring = Ring::create(name, Capacity);
+    std::fflush(stdout); // not to print it again from the child
+    auto start = Clock::now();
+    auto child = fork();
+    if(0 == child) {
+        try {
+            auto attached = Ring::attach(name);
+            auto volume = consume(attached.consumer(), count);
+            std::printf(
+                "consumer process: volume %lld\n", (long long)volume
+            );
+            std::fflush(stdout);
+            _exit(0);
+        } catch(std::exception &e) {
+            std::fprintf(stderr, "%s\n", e.what());
+            _exit(1);
+        }
+    }
+    produce(ring.producer(), count);
+    int status;
+    waitpid(child, &status, 0);
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::printf(
+        "cross process SharedRing: %6.1f M msgs/s, consumer %s\n",
+        count / elapsed.count() / 1e6,
+        WIFEXITED(status) && !WEXITSTATUS(status) ? "ok" : "FAILED"
+    );
+
+    // the handshake rejects a different message space
+    try {
+        meta::SharedRing<Pack<Trade, Uptick>>::attach(name);
+        std::printf("mismatched attach: NOT DETECTED\n");
+    } catch(std::runtime_error &e) {
+        std::printf("mismatched attach: %s\n", e.what());
+    }
+
+    // the positions are masked, the capacities must be powers of two
+    for(std::size_t capacity: { std::size_t(0), std::size_t(3000) }) {
+        try {
+            Ring::create(name + "_invalid", capacity);
+            std::printf("capacity %zu: NOT REJECTED\n", capacity);
+        } catch(std::invalid_argument &e) {
+            std::printf("capacity %zu: %s\n", capacity, e.what());
+        }
+    }
+}
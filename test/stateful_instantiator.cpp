@@ -0,0 +1,55 @@
+/// \file stateful_instantiator.cpp
+/// \c StatefulInstantiator at run time: the states start value initialized,
+/// also in a block placed over dirty memory, each index counts its own
+/// calls, and each thread has its own block
+
+#include <meta/StatefulInstantiator.h>
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+
+template<std::size_t I>
+struct Counting {
+    using state_t = std::conditional_t<1 == I, unsigned char, long>;
+
+    static long execute(state_t &count, long step) {
+        count += state_t(step);
+        return long(count);
+    }
+};
+
+template<>
+struct Counting<2> {
+    static long execute(long step) { return -step; }
+};
+
+using Counter = meta::StatefulInstantiator<Counting, 4, long(long)>;
+
+int main() {
+    auto failures = 0;
+
+    alignas(Counter::States) unsigned char dirty[sizeof(Counter::States)];
+    std::memset(dirty, 0xA5, sizeof(dirty));
+    auto &states = *new(dirty) Counter::States;
+    failures +=
+        0 != states.get<0>() || 0 != states.get<1>() || 0 != states.get<3>();
+    for(std::size_t i = 0; i < 4; ++i) {
+        for(long call = 1; call <= 3; ++call) {
+            auto expected = 2 == i ? -(long(i) + 1) : call * (long(i) + 1);
+            failures +=
+                expected != Counter::executeWith(states, long(i) + 1, i);
+        }
+    }
+    failures += 3 != states.get<0>() || 12 != states.get<3>();
+    states.~States();
+
+    for(std::size_t i = 0; i < 4; ++i) { Counter::execute(1, i); }
+    long other = -1;
+    std::thread([&] { other = Counter::execute(1, 3); }).join();
+    failures += 1 != other || 2 != Counter::execute(1, 3);
+
+    std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
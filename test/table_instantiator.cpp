@@ -0,0 +1,39 @@
+/// \file table_instantiator.cpp
+/// \c TableInstantiator at run time: handlers that are only constants become
+/// a load from a \c Table, handlers with an \c execute are called, even when
+/// they also have a \c value
+
+#include <meta/Table.h>
+
+#include <cstdio>
+
+template<std::size_t I>
+struct Square {
+    constexpr static int value = int(I * I);
+};
+
+int calls = 0;
+
+template<std::size_t I>
+struct Scaled: std::integral_constant<int, -1> {
+    static int execute(int x) {
+        ++calls;
+        return x * int(I);
+    }
+};
+
+int main() {
+    using Squares = meta::TableInstantiator<Square, 8, int(int)>;
+    using Products = meta::TableInstantiator<Scaled, 5, int(int)>;
+    static_assert(Squares::isTable && !Products::isTable, "");
+    auto failures = 0;
+    for(std::size_t i = 0; i < 8; ++i) {
+        failures += Squares::execute(7, i) != int(i * i);
+    }
+    for(std::size_t i = 0; i < 5; ++i) {
+        failures += Products::execute(7, i) != 7 * int(i);
+    }
+    failures += 5 != calls;
+    std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+/// \file timer_wheel.cpp
+/// Benchmark of \c TimerWheel in a busy poll loop that advances the time on
+/// every iteration: session heartbeats that re-arm themselves, order timeouts
+/// mostly cancelled before they expire and throttling windows, fired through
+/// an \c Instantiator table.  The baseline is a heap of \c std::function with
+/// cancellation flags.  Every event carries its deadline to check it fires on
+/// time.
+
+#include <meta/TimerWheel.h>
+#include <meta/PackIndexer.h>
+#include <meta/Instantiator.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+struct Heartbeat {
+    std::uint64_t deadline;
+    std::uint32_t session;
+};
+
+struct OrderTimeout {
+    std::uint64_t deadline;
+    std::uint64_t order;
+};
+
+struct ThrottleWindow {
+    std::uint64_t deadline;
+    std::uint32_t session;
+    std::uint32_t credits;
+};
+
+using TimerEvents = Pack<Heartbeat, OrderTimeout, ThrottleWindow>;
+
+constexpr std::uint64_t HeartbeatPeriod = 10000;
+
+using Wheel = meta::TimerWheel<TimerEvents>;
+
+struct Counters {
+    std::uint64_t heartbeats = 0, timeouts = 0, windows = 0, late = 0;
+};
+
+struct Context {
+    Wheel &wheel;
+    Counters counters;
+};
+
+void check(Context &c, std::uint64_t deadline) {
+    if(c.wheel.now() != deadline) { ++c.counters.late; }
+}
+
+void onTimer(Context &c, const Heartbeat &h) {
+    check(c, h.deadline);
+    ++c.counters.heartbeats;
+    auto next = h;
+    next.deadline += HeartbeatPeriod;
+    c.wheel.schedule(next.deadline, next);
+}
+
+void onTimer(Context &c, const OrderTimeout &o) {
+    check(c, o.deadline);
+    ++c.counters.timeouts;
+}
+
+void onTimer(Context &c, const ThrottleWindow &w) {
+    check(c, w.deadline);
+    ++c.counters.windows;
+}
+
+template<typename Event>
+struct TimerHandler {
+    static void execute(Context &c, const void *event) {
+        onTimer(c, *static_cast<const Event *>(event));
+    }
+};
+
+void dispatch(Context &c, const void *event, std::size_t index) {
+    meta::Instantiator<
+        meta::PackIndexer<TimerHandler, TimerEvents>::Internal,
+        3,
+        void(Context &, const void *)
+    >::execute(c, event, index);
+}
+
+/// \brief What the loop does at each iteration, the same for both
+struct Script {
+    std::mt19937_64 random{5};
+
+    bool order(std::uint64_t) { return 0 == random() % 4; }
+    std::uint64_t timeout() { return 100 + random() % 100000; }
+    bool cancel() { return random() % 10 < 2; }
+    bool window(std::uint64_t now) { return 0 == now % 16; }
+};
+
+struct Baseline {
+    struct Entry {
+        std::uint64_t deadline, sequence;
+        std::function<void()> action;
+
+        bool operator<(const Entry &other) const {
+            return other.deadline < deadline ||
+                (other.deadline == deadline && other.sequence < sequence);
+        }
+    };
+
+    std::priority_queue<Entry> heap;
+    std::vector<bool> cancelled;
+    std::uint64_t now = 0, sequence = 0;
+
+    std::uint64_t schedule(std::uint64_t deadline, std::function<void()> f) {
+        cancelled.push_back(false);
+        heap.push({ deadline, sequence, std::move(f) });
+        return sequence++;
+    }
+
+    void advance(std::uint64_t to) {
+        now = to;
+        while(!heap.empty() && heap.top().deadline <= now) {
+            auto e = heap.top();
+            heap.pop();
+            if(!cancelled[e.sequence]) { e.action(); }
+        }
+    }
+};
+
+int main(int argc, char **argv) {
+    std::uint64_t iterations =
+        1 < argc ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    constexpr std::uint32_t Sessions = 64;
+    using Clock = std::chrono::steady_clock;
+
+    Wheel wheel(1 << 16);
+    Context context{wheel, {}};
+    std::vector<meta::TimerHandle> pending;
+    for(std::uint32_t s = 0; s < Sessions; ++s) {
+        auto deadline = 1 + s * (HeartbeatPeriod / Sessions);
+        wheel.schedule(deadline, Heartbeat{deadline, s});
+    }
+    Script script;
+    auto start = Clock::now();
+    for(std::uint64_t now = 1; now <= iterations; ++now) {
+        wheel.advance(now, [&](const void *event, std::size_t index) {
+            dispatch(context, event, index);
+        });
+        if(script.order(now)) {
+            auto deadline = now + script.timeout();
+            pending.push_back(
+                wheel.schedule(deadline, OrderTimeout{deadline, now})
+            );
+        }
+        if(!pending.empty() && script.cancel()) {
+            auto i = script.random() % pending.size();
+            wheel.cancel(pending[i]);
+            pending[i] = pending.back();
+            pending.pop_back();
+        }
+        if(script.window(now)) {
+            wheel.schedule(now + 1000, ThrottleWindow{now + 1000, 0, 100});
+        }
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    auto &c = context.counters;
+    std::printf(
+        "timer wheel:  %5.1f ns/iteration, fired %llu heartbeats, "
+        "%llu timeouts, %llu windows, %llu late\n",
+        elapsed.count() * 1e9 / iterations,
+        (unsigned long long)c.heartbeats, (unsigned long long)c.timeouts,
+        (unsigned long long)c.windows, (unsigned long long)c.late
+    );
+
+    Baseline baseline;
+    Counters b;
+    std::vector<std::uint64_t> ids;
+    std::function<void(std::uint64_t, std::uint32_t)> heartbeat =
+        [&](std::uint64_t deadline, std::uint32_t session) {
+            b.late += baseline.now != deadline;
+            ++b.heartbeats;
+            auto next = deadline + HeartbeatPeriod;
+            baseline.schedule(next, [&, next, session] {
+                heartbeat(next, session);
+            });
+        };
+    for(std::uint32_t s = 0; s < Sessions; ++s) {
+        auto deadline = 1 + s * (HeartbeatPeriod / Sessions);
+        baseline.schedule(deadline, [&, deadline, s] {
+            heartbeat(deadline, s);
+        });
+    }
+    script = Script{};
+    start = Clock::now();
+    for(std::uint64_t now = 1; now <= iterations; ++now) {
+        baseline.advance(now);
+        if(script.order(now)) {
+            auto deadline = now + script.timeout();
+            ids.push_back(baseline.schedule(deadline, [&, deadline] {
+                b.late += baseline.now != deadline;
+                ++b.timeouts;
+            }));
+        }
+        if(!ids.empty() && script.cancel()) {
+            auto i = script.random() % ids.size();
+            baseline.cancelled[ids[i]] = true;
+            ids[i] = ids.back();
+            ids.pop_back();
+        }
+        if(script.window(now)) {
+            auto deadline = now + 1000;
+            baseline.schedule(deadline, [&, deadline] {
+                b.late += baseline.now != deadline;
+                ++b.windows;
+            });
+        }
+    }
+    elapsed = Clock::now() - start;
+    std::printf(
+        "function heap: %5.1f ns/iteration, fired %llu heartbeats, "
+        "%llu timeouts, %llu windows, %llu late\n",
+        elapsed.count() * 1e9 / iterations,
+        (unsigned long long)b.heartbeats, (unsigned long long)b.timeouts,
+        (unsigned long long)b.windows, (unsigned long long)b.late
+    );
+}
@@ -0,0 +1,119 @@
+/// \file timer_wheel_check.cpp
+/// Randomized check of \c TimerWheel against a \c std::map of the pending
+/// deadlines, with 2, 3 and 4 levels: every timer must fire exactly at its
+/// deadline, never when cancelled, and none may be left behind.  Advances
+/// mix single ticks, jumps within a revolution of the lowest levels and
+/// jumps far ahead; some handlers schedule and cancel while firing.
+
+#include <meta/TimerWheel.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+struct Event {
+    std::uint64_t deadline;
+    std::uint64_t id;
+};
+
+struct Failures {
+    std::uint64_t wrongTime = 0, unexpected = 0, lost = 0;
+
+    std::uint64_t total() const { return wrongTime + unexpected + lost; }
+};
+
+template<std::size_t Levels>
+Failures check(std::uint64_t seed, std::size_t operations, unsigned bits) {
+    using Wheel = meta::TimerWheel<Pack<Event>, Levels>;
+    std::mt19937_64 random(seed);
+    Wheel wheel(1 << 12, random() % (1ull << bits));
+    std::map<std::uint64_t, std::uint64_t> pending; // id to deadline
+    std::vector<std::pair<std::uint64_t, meta::TimerHandle>> handles;
+    std::uint64_t ids = 0;
+    Failures rv;
+
+    auto schedule = [&](std::uint64_t deadline) {
+        auto id = ids++;
+        auto h = wheel.schedule(deadline, Event{deadline, id});
+        if(~std::uint32_t(0) == h.node) { return; }
+        pending[id] = deadline;
+        handles.push_back({ id, h });
+    };
+    auto distance = [&]() -> std::uint64_t {
+        switch(random() % 4) {
+            case 0: return 1 + random() % 256;
+            case 1: return 1 + random() % (1 << 16);
+            default: return 1 + random() % (1ull << bits);
+        }
+    };
+    auto sink = [&](const void *message, std::size_t) {
+        auto &e = *static_cast<const Event *>(message);
+        auto found = pending.find(e.id);
+        if(pending.end() == found) { ++rv.unexpected; return; }
+        if(wheel.now() != e.deadline) { ++rv.wrongTime; }
+        pending.erase(found);
+        if(0 == e.id % 7) { schedule(wheel.now() + distance()); }
+    };
+
+    for(std::size_t i = 0; i < operations; ++i) {
+        auto dice = random() % 10;
+        if(dice < 5) {
+            schedule(wheel.now() + distance());
+        } else if(dice < 7 && !handles.empty()) {
+            auto k = random() % handles.size();
+            if(wheel.cancel(handles[k].second)) {
+                pending.erase(handles[k].first);
+            }
+            handles[k] = handles.back();
+            handles.pop_back();
+        } else {
+            std::uint64_t step = 0 == random() % 3 ? 1 : distance() / 4;
+            wheel.advance(wheel.now() + step, sink);
+        }
+        if(handles.size() > 4 * wheel.size() + 64) {
+            // drops the handles of the timers that fired
+            std::vector<std::pair<std::uint64_t, meta::TimerHandle>> live;
+            for(auto &h: handles) {
+                if(pending.count(h.first)) { live.push_back(h); }
+            }
+            handles.swap(live);
+        }
+    }
+    // the handlers firing on the way may schedule more
+    for(std::size_t round = 0; !pending.empty() && round < 100; ++round) {
+        std::uint64_t last = wheel.now();
+        for(auto &p: pending) { last = std::max(last, p.second); }
+        wheel.advance(last, sink);
+    }
+    rv.lost = std::max<std::uint64_t>(pending.size(), wheel.size());
+    return rv;
+}
+
+template<std::size_t Levels>
+bool report(std::size_t operations) {
+    Failures f;
+    for(std::uint64_t seed = 1; seed <= 20; ++seed) {
+        auto r = check<Levels>(seed, operations, 30);
+        f.wrongTime += r.wrongTime;
+        f.unexpected += r.unexpected;
+        f.lost += r.lost;
+    }
+    std::printf(
+        "%zu levels: %llu at the wrong time, %llu unexpected, %llu lost\n",
+        Levels, (unsigned long long)f.wrongTime,
+        (unsigned long long)f.unexpected, (unsigned long long)f.lost
+    );
+    return !f.total();
+}
+
+int main(int argc, char **argv) {
+    std::size_t operations =
+        1 < argc ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    auto ok = report<2>(operations);
+    ok = report<3>(operations) && ok;
+    ok = report<4>(operations) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/// \file tuple_visit.cpp
+/// \c visitAt, \c elementAddress and \c elementAt with runtime indices on
+/// a tuple of per-type states and on homogeneous tuples, checked against
+/// \c std::get; then the cost of \c elementAt from its table of offsets
+/// against the \c elementAddress jump table and a \c std::array
+
+#include <meta/TupleVisit.h>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+template<typename T>
+struct State {
+    T last{};
+    unsigned seen = 0;
+};
+
+using States = std::tuple<State<char>, State<double>, State<std::string>>;
+
+struct Seen {
+    template<typename T>
+    unsigned &operator()(State<T> &s) { return s.seen; }
+};
+
+int main() {
+    auto failures = 0;
+    States states;
+    for(std::size_t i = 0; i < 6; ++i) {
+        ++meta::visitAt(states, i % 3, Seen{});
+    }
+    failures +=
+        2 != std::get<0>(states).seen || 2 != std::get<1>(states).seen ||
+        2 != std::get<2>(states).seen;
+
+    const auto &constant = states;
+    failures +=
+        meta::elementAddress(constant, 0) != &std::get<0>(states) ||
+        meta::elementAddress(constant, 1) != &std::get<1>(states) ||
+        meta::elementAddress(states, 2) != &std::get<2>(states);
+    static_cast<State<std::string> *>(meta::elementAddress(states, 2))->last =
+        "trade";
+    failures += "trade" != std::get<2>(states).last;
+
+    std::tuple<long, long, long> counts{1, 2, 3};
+    for(std::size_t i = 0; i < 3; ++i) { meta::elementAt(counts, i) *= 10; }
+    const auto &constantCounts = counts;
+    failures +=
+        10 != std::get<0>(counts) || 20 != std::get<1>(counts) ||
+        30 != meta::elementAt(constantCounts, 2);
+
+    std::tuple<std::string, std::string> names{"bid", "ask"};
+    static_assert(!meta::TabulatedTuple_v<decltype(names)>, "");
+    meta::elementAt(names, 1) += "s";
+    failures += "asks" != std::get<1>(names);
+
+    std::printf("%d failures\n", failures);
+    if(failures) { return 1; }
+
+    // the cost per access of each, the indices random
+    using Eight = std::tuple<long, long, long, long, long, long, long, long>;
+    Eight eight{};
+    std::array<long, 8> array{};
+    std::vector<unsigned char> indices(1 << 20);
+    for(auto &i: indices) { i = std::rand() % 8; }
+    using Clock = std::chrono::steady_clock;
+    auto time = [&](const char *label, auto &&access) {
+        auto start = Clock::now();
+        for(auto round = 0; round < 50; ++round) {
+            for(auto i: indices) { ++access(i); }
+        }
+        std::chrono::duration<double, std::nano> elapsed =
+            Clock::now() - start;
+        std::printf(
+            "%-16s %.2f ns/access\n", label,
+            elapsed.count() / (50.0 * indices.size())
+        );
+    };
+    std::printf(
+        "elementAt is %s\n",
+        meta::TabulatedTuple_v<Eight> ? "tabulated" : "the jump table"
+    );
+    time("elementAt", [&](std::size_t i) -> long & {
+        return meta::elementAt(eight, i);
+    });
+    time("elementAddress", [&](std::size_t i) -> long & {
+        return *static_cast<long *>(meta::elementAddress(eight, i));
+    });
+    time("std::array", [&](std::size_t i) -> long & { return array[i]; });
+    // the tuple counted the indices twice
+    return std::get<3>(eight) == 2 * array[3] ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/// \file warm_restart.cpp
+/// Restart of order book handlers from a \c StateSnapshot against replaying
+/// the whole day.  The state is flat, trivially copyable books per instrument
+/// and the count of messages per type, updated in place by handlers
+/// dispatched through an \c Instantiator.  The day is a deterministic stream
+/// of the \c OrderBook.h messages, a function of the sequence number, thus
+/// any part of it can be replayed.  The state restored and caught up must be
+/// the state of the uninterrupted run.
+
+#include "OrderBook.h"
+
+#include <meta/StateSnapshot.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace book;
+
+constexpr std::size_t Ticks = 1024;
+constexpr std::uint32_t Instruments = 256;
+
+/// \brief The levels around a fixed anchor, with everything else of the
+/// instrument, without pointers
+struct FlatBook {
+    Price anchor;
+    Quantity bids[2][Ticks], asks[2][Ticks]; ///< by \c LiquidityProvider
+    Quantity tradedVolume;
+    Price lastTrade;
+    std::uint32_t upticks;
+};
+
+struct Progress {
+    std::uint64_t messages[10]; ///< by index in \c MessageTypeArray
+};
+
+using State = Pack<FlatBook, Progress>;
+
+struct Handlers {
+    FlatBook *books;
+    Progress *progress;
+};
+
+template<typename Message>
+struct FlatHandler;
+
+template<bool Top, QuoteSide S, LiquidityProvider LP>
+struct FlatHandler<Quote<Top, S, LP>> {
+    static void execute(Handlers &h, const void *message) {
+        auto &q = *static_cast<const Quote<Top, S, LP> *>(message);
+        auto &book = h.books[q.instrument];
+        auto level = std::size_t(q.price - book.anchor + Price(Ticks / 2));
+        if(Ticks <= level) { return; }
+        auto &levels = BID == S ? book.bids[LP] : book.asks[LP];
+        if constexpr(Top) {
+            // the more aggressive levels are gone
+            if(BID == S) {
+                for(auto l = level + 1; l < Ticks; ++l) { levels[l] = 0; }
+            } else {
+                for(std::size_t l = 0; l < level; ++l) { levels[l] = 0; }
+            }
+        }
+        levels[level] = q.quantity;
+    }
+};
+
+template<>
+struct FlatHandler<Trade> {
+    static void execute(Handlers &h, const void *message) {
+        auto &t = *static_cast<const Trade *>(message);
+        h.books[t.instrument].tradedVolume += t.quantity;
+        h.books[t.instrument].lastTrade = t.price;
+    }
+};
+
+template<>
+struct FlatHandler<Uptick> {
+    static void execute(Handlers &h, const void *message) {
+        ++h.books[static_cast<const Uptick *>(message)->instrument].upticks;
+    }
+};
+
+void apply(Handlers &h, const void *message, std::size_t index) {
+    ++h.progress->messages[index];
+    meta::Instantiator<
+        meta::PackIndexer<FlatHandler, MessageTypeArray>::Internal,
+        10,
+        void(Handlers &, const void *)
+    >::execute(h, message, index);
+}
+
+std::uint64_t mix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/// \brief message \c sequence of the day, to \c h
+void replay(Handlers &h, std::uint64_t sequence) {
+    auto random = mix(sequence);
+    auto instrument = std::uint32_t(random % Instruments);
+    auto price = Price(100000 + (random >> 8) % 64) - 32;
+    auto quantity = Quantity((random >> 16) % 50);
+    auto dispatch = [&](const auto &m) {
+        apply(h, &m, meta::IndexOf_v<
+            std::decay_t<decltype(m)>, MessageTypeArray
+        >);
+    };
+    switch((random >> 24) % 16) {
+        case 0: dispatch(Trade{instrument, quantity + 1, price}); break;
+        case 1: dispatch(Uptick{instrument}); break;
+        case 2:
+            dispatch(Quote<true, BID, OUTRIGHT>{instrument, quantity, price});
+            break;
+        case 3:
+            dispatch(Quote<true, ASK, OUTRIGHT>{instrument, quantity, price});
+            break;
+        case 4: case 5: case 6: case 7:
+            dispatch(Quote<false, BID, OUTRIGHT>{instrument, quantity, price});
+            break;
+        case 8: case 9: case 10: case 11:
+            dispatch(Quote<false, ASK, OUTRIGHT>{instrument, quantity, price});
+            break;
+        case 12: case 13:
+            dispatch(Quote<false, BID, IMPLIED>{instrument, quantity, price});
+            break;
+        default:
+            dispatch(Quote<false, ASK, IMPLIED>{instrument, quantity, price});
+    }
+}
+
+int main(int argc, char **argv) {
+    std::uint64_t day =
+        1 < argc ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+    auto tail = day / 50;
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+    using Snapshot = meta::StateSnapshot<State>;
+    auto path = "/tmp/zoo_meta_snapshot_" + std::to_string(getpid());
+
+    std::vector<FlatBook> books(Instruments);
+    for(auto &b: books) {
+        std::memset(&b, 0, sizeof(b));
+        b.anchor = 100000;
+    }
+    Progress progress = {};
+    Handlers running{books.data(), &progress};
+    auto start = Clock::now();
+    for(std::uint64_t s = 0; s < day; ++s) { replay(running, s); }
+    Seconds fullReplay = Clock::now() - start;
+
+    start = Clock::now();
+    {
+        auto snapshot = Snapshot::create(path, {{ Instruments, 1 }});
+        std::memcpy(
+            snapshot.data<FlatBook>(), books.data(),
+            Instruments * sizeof(FlatBook)
+        );
+        *snapshot.data<Progress>() = progress;
+        snapshot.commit(day);
+    }
+    Seconds saving = Clock::now() - start;
+    for(auto s = day; s < day + tail; ++s) { replay(running, s); }
+
+    // the restart
+    start = Clock::now();
+    auto restored = Snapshot::open(path);
+    Handlers warm{restored.data<FlatBook>(), restored.data<Progress>()};
+    Seconds ready = Clock::now() - start;
+    for(auto s = restored.sequence(); s < day + tail; ++s) {
+        replay(warm, s);
+    }
+    Seconds caughtUp = Clock::now() - start;
+
+    auto same =
+        Instruments == restored.count<FlatBook>() &&
+        !std::memcmp(warm.books, books.data(), Instruments * sizeof(FlatBook))
+        && !std::memcmp(warm.progress, &progress, sizeof(progress));
+    std::printf(
+        "replay of %llu messages: %.3f s\n"
+        "snapshot of %zu KiB:     %.3f s\n"
+        "restart, mapped:        %.6f s, caught up on %llu messages: %.3f s, "
+        "state %s\n",
+        (unsigned long long)day, fullReplay.count(),
+        Instruments * sizeof(FlatBook) / 1024, saving.count(),
+        ready.count(), (unsigned long long)tail, caughtUp.count(),
+        same ? "identical" : "DIFFERENT"
+    );
+
+    try {
+        meta::StateSnapshot<Pack<Progress, FlatBook>>::open(path);
+        std::printf("mismatched layout: NOT DETECTED\n");
+    } catch(std::runtime_error &e) {
+        std::printf("mismatched layout: %s\n", e.what());
+    }
+    {
+        // moves the section of the progress off the alignment of its type
+        meta::SnapshotSection progressSection;
+        auto at = off_t(
+            sizeof(meta::SnapshotHeader) + sizeof(meta::SnapshotSection)
+        );
+        auto fd = ::open(path.c_str(), O_RDWR);
+        pread(fd, &progressSection, sizeof(progressSection), at);
+        ++progressSection.offset;
+        pwrite(fd, &progressSection, sizeof(progressSection), at);
+        close(fd);
+    }
+    try {
+        Snapshot::open(path);
+        std::printf("misaligned section: NOT DETECTED\n");
+    } catch(std::runtime_error &e) {
+        std::printf("misaligned section: %s\n", e.what());
+    }
+    unlink(path.c_str());
+    return same ? 0 : 1;
+}